@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/* Toggle functions (&paw_mode parameter) */
+#define PAW_TOG_MOVE_SCROLL 0
+#define PAW_TOG_NORMAL_SNIPE 1
+#define PAW_TOG_VERT_HORIZ 2
+
+/* Mode indices, matching enum paw32xx_current_mode */
+#define PAW_MODE_MOVE 0
+#define PAW_MODE_SCROLL 1
+#define PAW_MODE_SCROLL_HORIZONTAL 2
+#define PAW_MODE_SNIPE 3
+#define PAW_MODE_SCROLL_SNIPE 4
+#define PAW_MODE_SCROLL_HORIZONTAL_SNIPE 5
+#define PAW_MODE_BOTHSCROLL 6
+#define PAW_MODE_BOTHSCROLL_SNIPE 7
+
+/* Momentary functions: switch to a mode while the key is held */
+#define PAW_HOLD_BASE 0x100
+#define PAW_HOLD(mode) (PAW_HOLD_BASE | (mode))
+
+#define PAW_HOLD_SCROLL PAW_HOLD(PAW_MODE_SCROLL)
+#define PAW_HOLD_SCROLL_HORIZONTAL PAW_HOLD(PAW_MODE_SCROLL_HORIZONTAL)
+#define PAW_HOLD_SNIPE PAW_HOLD(PAW_MODE_SNIPE)
+#define PAW_HOLD_SCROLL_SNIPE PAW_HOLD(PAW_MODE_SCROLL_SNIPE)
+#define PAW_HOLD_SCROLL_HORIZONTAL_SNIPE PAW_HOLD(PAW_MODE_SCROLL_HORIZONTAL_SNIPE)
+#define PAW_HOLD_BOTHSCROLL PAW_HOLD(PAW_MODE_BOTHSCROLL)
+#define PAW_HOLD_BOTHSCROLL_SNIPE PAW_HOLD(PAW_MODE_BOTHSCROLL_SNIPE)
+
+/* Direct functions: switch to a mode or profile in one action */
+#define PAW_SET_BASE 0x200
+#define PAW_SET(mode) (PAW_SET_BASE | (mode))
+#define PAW_PROFILE_BASE 0x300
+#define PAW_PROFILE(n) (PAW_PROFILE_BASE | (n))
+
+#define PAW_SET_MOVE PAW_SET(PAW_MODE_MOVE)
+#define PAW_SET_SCROLL PAW_SET(PAW_MODE_SCROLL)
+#define PAW_SET_SCROLL_HORIZONTAL PAW_SET(PAW_MODE_SCROLL_HORIZONTAL)
+#define PAW_SET_SNIPE PAW_SET(PAW_MODE_SNIPE)
+#define PAW_SET_SCROLL_SNIPE PAW_SET(PAW_MODE_SCROLL_SNIPE)
+#define PAW_SET_SCROLL_HORIZONTAL_SNIPE PAW_SET(PAW_MODE_SCROLL_HORIZONTAL_SNIPE)
+#define PAW_SET_BOTHSCROLL PAW_SET(PAW_MODE_BOTHSCROLL)
+#define PAW_SET_BOTHSCROLL_SNIPE PAW_SET(PAW_MODE_BOTHSCROLL_SNIPE)
@@ -18,8 +18,35 @@
 #include <zephyr/drivers/spi.h>
 #include <zephyr/kernel.h>
 
+#include "paw3222_idle.h"
+#include "paw3222_recfmt.h"
+#include "paw3222_regs.h"
+
 /* These functions are declared in paw3222_power.h */
 
+#ifdef CONFIG_PAW3222_SENSOR
+struct rtio_iodev_sqe;
+
+/**
+ * @brief Sensor API state for a PAW3222 instance
+ *
+ * Holds the latest sample until a one-shot read or a fetch consumes it,
+ * and the pending streaming request that motion samples are batched into.
+ */
+struct paw32xx_sensor_state {
+  struct k_spinlock lock;                     /**< Protects the fields below */
+  struct rtio_iodev_sqe *stream_sqe;          /**< Pending streaming request, or NULL */
+  uint8_t *stream_buf;                        /**< Buffer of the pending streaming request */
+  uint32_t stream_buf_len;                    /**< Size of stream_buf in bytes */
+  uint64_t last_timestamp_ns;                 /**< Timestamp of the latest sample */
+  int16_t last_x;                             /**< Latest raw X delta */
+  int16_t last_y;                             /**< Latest raw Y delta */
+  bool fresh;                                 /**< Latest sample not read yet */
+  int16_t fetched_x;                          /**< X delta of the last sample_fetch() */
+  int16_t fetched_y;                          /**< Y delta of the last sample_fetch() */
+};
+#endif
+
 /**
  * @brief Input mode switching methods
  * 
@@ -44,8 +71,322 @@ enum paw32xx_current_mode {
   PAW32XX_MODE_SCROLL_SNIPE,            /**< High-precision vertical scrolling mode */
   PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE, /**< High-precision horizontal scrolling mode */
   PAW32XX_MODE_BOTHSCROLL,              /**< XY同時スクロールモード */
+  PAW32XX_MODE_BOTHSCROLL_SNIPE,        /**< High-precision XY simultaneous scrolling mode */
+};
+
+/** @brief Number of entries in enum paw32xx_current_mode */
+#define PAW32XX_MODE_COUNT (PAW32XX_MODE_BOTHSCROLL_SNIPE + 1)
+
+#ifndef CONFIG_PAW3222_MODE_STACK_DEPTH
+#define CONFIG_PAW3222_MODE_STACK_DEPTH 4
+#endif
+
+/**
+ * @brief Entry of the per-device mode stack
+ *
+ * Momentary (hold) bindings push an entry on press and remove it again on
+ * release. The entry is identified by the key position of the binding, so
+ * releases may happen in any order.
+ */
+struct paw32xx_mode_stack_entry {
+  enum paw32xx_current_mode mode;             /**< Mode active while the entry is on top */
+  uint32_t position;                          /**< Key position of the binding that pushed it */
 };
 
+#ifdef CONFIG_PAW3222_LATENCY
+/** @brief Number of log2 buckets per latency histogram */
+#define PAW32XX_LATENCY_BUCKETS 16
+
+/**
+ * @brief Motion pipeline stages measured by the latency histograms
+ */
+enum paw32xx_latency_stage {
+  PAW32XX_LATENCY_IRQ_TO_SPI,    /**< Motion IRQ edge to completed X/Y read */
+  PAW32XX_LATENCY_SPI_TO_REPORT, /**< Completed X/Y read to synced input report */
+  PAW32XX_LATENCY_IRQ_TO_REPORT, /**< Motion IRQ edge to synced input report */
+  PAW32XX_LATENCY_SPI_TO_HID,    /**< Completed X/Y read to the report reaching the HID side */
+  PAW32XX_LATENCY_STAGE_COUNT,
+};
+
+/**
+ * @brief Per-device latency histograms
+ *
+ * Bucket 0 counts latencies below 1 us, bucket i counts latencies in
+ * [2^(i-1), 2^i) us and the last bucket also collects everything above.
+ */
+struct paw32xx_latency {
+  struct k_spinlock lock;                     /**< Protects the histograms */
+  uint32_t irq_cyc;                           /**< Cycle count of the last motion IRQ */
+  uint32_t spi_cyc;                           /**< Cycle count of the last completed X/Y read */
+  atomic_t pending;                           /**< PAW32XX_LATENCY_PENDING_* flags */
+  uint32_t hid_cyc;                           /**< X/Y read of the report awaiting the HID side */
+  atomic_t hid_pending;                       /**< hid_cyc is set; cleared by the HID side */
+  uint32_t hist[PAW32XX_LATENCY_STAGE_COUNT][PAW32XX_LATENCY_BUCKETS]; /**< Sample counts */
+  uint32_t max_us[PAW32XX_LATENCY_STAGE_COUNT]; /**< Largest latency seen per stage */
+};
+#endif
+
+#ifdef CONFIG_PAW3222_TRACE
+/**
+ * @brief Binary trace record
+ *
+ * Meaning of @ref arg, @ref a and @ref b depends on @ref type, see
+ * enum paw32xx_trace_type in paw3222_trace.h.
+ */
+struct paw32xx_trace_rec {
+  uint32_t cycles;                            /**< Hardware cycle count when recorded */
+  uint8_t type;                               /**< enum paw32xx_trace_type */
+  uint8_t arg;                                /**< Type specific small argument */
+  int16_t a;                                  /**< Type specific value */
+  int16_t b;                                  /**< Type specific value */
+};
+
+/**
+ * @brief Per-device trace ring buffer
+ *
+ * Records are addressed by a free-running sequence number; once the ring
+ * is full the oldest records are overwritten.
+ */
+struct paw32xx_trace {
+  struct k_spinlock lock;                     /**< Protects the ring */
+  uint32_t next_seq;                          /**< Sequence number of the next record */
+  struct paw32xx_trace_rec recs[CONFIG_PAW3222_TRACE_DEPTH]; /**< Ring storage */
+};
+#endif
+
+/**
+ * @brief Operations whose cycle cost is measured
+ *
+ * The first entries are the motion work handler cost per sample, indexed
+ * by enum paw32xx_input_mode.
+ */
+enum paw32xx_cycle_op {
+  PAW32XX_CYCLES_SAMPLE_BASE = 0,   /**< Per-sample cost, + input mode */
+  PAW32XX_CYCLES_MODE_RESOLVE =
+      PAW32XX_BOTHSCROLL_SNIPE + 1, /**< Effective mode resolution */
+  PAW32XX_CYCLES_CPI_SWITCH,        /**< CPI register update */
+  PAW32XX_CYCLES_IDLE_ENTER,        /**< Idle entry */
+  PAW32XX_CYCLES_IDLE_EXIT,         /**< Idle exit */
+  PAW32XX_CYCLES_OP_COUNT,
+};
+
+#ifdef CONFIG_PAW3222_RECORDER
+/**
+ * @brief Motion recording storage, laid out as described in paw3222_recfmt.h
+ *
+ * Placed in a no-init section when CONFIG_PAW3222_RECORDER_RETAINED is set
+ * so that a recording survives a warm reboot.
+ */
+struct paw32xx_rec_ring {
+  struct paw32xx_rec_ring_hdr hdr;                   /**< Ring header */
+  uint8_t blocks[CONFIG_PAW3222_RECORDER_BLOCKS]
+                [PAW32XX_REC_BLOCK_SIZE];            /**< Block storage */
+};
+
+/**
+ * @brief Motion recorder encoder state
+ */
+struct paw32xx_recorder {
+  struct k_spinlock lock;                     /**< Protects the ring and the state below */
+  struct paw32xx_rec_sample prev;             /**< Last sample of the open block */
+  uint8_t *block;                             /**< Open block, NULL before the first sample */
+};
+#endif
+
+#ifdef CONFIG_PAW3222_CYCLE_STATS
+/**
+ * @brief Cycle statistics of one measured operation
+ */
+struct paw32xx_cycle_stat {
+  uint32_t count;                             /**< Number of measurements */
+  uint32_t max_cyc;                           /**< Most expensive measurement */
+  uint64_t total_cyc;                         /**< Sum of all measurements */
+};
+#endif
+
+/** @brief Motion polling interval while the sensor reports motion (ms) */
+#define PAW32XX_POLL_INTERVAL_MS 15
+
+/**
+ * @brief Runtime tunables
+ *
+ * Seeded from struct paw32xx_config at init. The motion path reads these
+ * instead of the configuration so they can be changed live, e.g. from the
+ * shell, without a rebuild.
+ */
+struct paw32xx_tuning {
+  int16_t res_cpi;                             /**< CPI of profile 0 */
+  int16_t snipe_cpi;                           /**< CPI used in snipe mode */
+  struct paw32xx_core_params core;             /**< Rotation, divisors and scroll ticks */
+  uint16_t poll_ms;                            /**< Motion polling interval while moving */
+  uint16_t reduced_scan_ms;                    /**< First polling interval after an idle exit (CONFIG_PAW3222_REDUCED_SCAN) */
+  uint32_t idle_timeout_s;                     /**< Inactivity before entering idle */
+};
+
+#ifdef CONFIG_PAW3222_STATS
+/**
+ * @brief Performance counters
+ *
+ * Plain counters updated from the IRQ handler and the motion work handler.
+ * They wrap on overflow and are only meant for diagnostics.
+ */
+struct paw32xx_stats {
+  uint32_t irqs;                               /**< Motion IRQs received */
+  uint32_t work_runs;                          /**< Motion work handler invocations */
+  uint32_t samples;                            /**< X/Y samples read from the sensor */
+  uint32_t reports;                            /**< Input reports generated */
+  uint32_t spi_errors;                         /**< Failed register reads in the motion path */
+  uint32_t cpi_writes;                         /**< CPI register updates */
+  uint32_t idle_entries;                       /**< Transitions into idle */
+  uint32_t idle_exits;                         /**< Transitions out of idle */
+  uint32_t mode_changes;                       /**< Effective input mode changes */
+  uint32_t work_delay_max_us;                  /**< Longest wait from work submission to handler start */
+  uint32_t report_block_max_us;                /**< Longest time the events of one report took to hand on */
+  uint32_t report_stalls;                      /**< Reports that blocked for PAW32XX_REPORT_STALL_US or more */
+  /* Not counters, kept by paw32xx_stats_reset(); must stay last */
+  uint32_t submit_cyc;                         /**< Cycle count of the oldest unhandled work submission */
+  bool submit_pending;                         /**< submit_cyc is valid */
+};
+
+/** @brief A synced report taking this long is counted as a stall */
+#define PAW32XX_REPORT_STALL_US 1000
+
+/** @brief Increment a performance counter in struct paw32xx_data */
+#define PAW32XX_STAT_INC(data, field) ((data)->stats.field++)
+#else
+#define PAW32XX_STAT_INC(data, field) do { } while (0)
+#endif
+
+#ifdef CONFIG_PAW3222_WARM_BOOT
+/** @brief Magic value of a valid struct paw32xx_warm ("PAWW") */
+#define PAW32XX_WARM_MAGIC 0x57574150U
+
+/**
+ * @brief Warm boot marker, kept in no-init RAM
+ *
+ * Valid while the sensor holds the configuration a previous boot wrote;
+ * cleared before a reset and when the device is suspended.
+ */
+struct paw32xx_warm {
+  uint32_t magic;                             /**< PAW32XX_WARM_MAGIC if valid */
+  uint32_t check;                             /**< ~magic; random RAM never matches both */
+};
+#endif
+
+#ifdef CONFIG_PAW3222_SNAPSHOT
+/** @brief Magic value of a valid struct paw32xx_snapshot ("PAWS") */
+#define PAW32XX_SNAPSHOT_MAGIC 0x53574150U
+/** @brief Layout version of struct paw32xx_snapshot */
+#define PAW32XX_SNAPSHOT_VERSION 2
+
+/**
+ * @brief Driver state kept across warm reboots
+ *
+ * Written to a no-init RAM section while the driver runs and read back
+ * on the next boot. The layout depends on the driver's Kconfig options;
+ * @ref size tells snapshots of a different build apart.
+ */
+struct paw32xx_snapshot {
+  uint32_t magic;                             /**< PAW32XX_SNAPSHOT_MAGIC */
+  uint32_t crc;                               /**< CRC-32 (IEEE) of everything after this field */
+  uint16_t version;                           /**< PAW32XX_SNAPSHOT_VERSION */
+  uint16_t size;                              /**< sizeof(struct paw32xx_snapshot) */
+  uint32_t boot;                              /**< Boot count of the session that wrote it */
+  uint32_t seq;                               /**< Save count within that session */
+  uint32_t uptime_ms;                         /**< Uptime at the save */
+  uint8_t idle;                               /**< Idle (sensor asleep) at the save */
+  uint8_t input_mode;                         /**< Resolved input mode at the save */
+  int16_t cpi;                                /**< Configured CPI at the save */
+#ifdef CONFIG_PAW3222_STATS
+  struct paw32xx_stats stats;                 /**< Performance counters */
+#endif
+#ifdef CONFIG_PAW3222_LATENCY
+  uint32_t latency_max_us[PAW32XX_LATENCY_STAGE_COUNT]; /**< Largest latency per stage */
+#endif
+#ifdef CONFIG_PAW3222_TRACE
+  uint32_t trace_seq;                         /**< Sequence number of trace[0] */
+  uint8_t trace_count;                        /**< Valid entries in trace, oldest first */
+  struct paw32xx_trace_rec trace[CONFIG_PAW3222_SNAPSHOT_TRACE_RECS]; /**< Newest trace records */
+#endif
+};
+
+/**
+ * @brief Retained snapshot storage
+ *
+ * Saves alternate between the two slots, so a reset in the middle of a
+ * save still leaves the previous one intact.
+ */
+struct paw32xx_snapshot_area {
+  struct paw32xx_snapshot slot[2];            /**< Written alternately, by seq */
+};
+
+/**
+ * @brief Snapshot state of a device
+ */
+struct paw32xx_snapshot_state {
+  struct k_work_delayable work;               /**< Saves the snapshot */
+  uint32_t boot;                              /**< Boot count of this session */
+  uint32_t seq;                               /**< Saves in this session */
+  bool prev_valid;                            /**< prev holds the last snapshot of the previous boot */
+  struct paw32xx_snapshot prev;               /**< Last snapshot of the previous boot */
+};
+#endif
+
+#ifdef CONFIG_PAW3222_LINE_MONITOR
+/**
+ * @brief Motion line health of a device
+ *
+ * Written by the motion work only, except edge which the motion IRQ sets.
+ */
+struct paw32xx_line {
+  atomic_t edge;                              /**< Set by the motion IRQ, taken by the motion work */
+  bool edge_run;                              /**< The current motion work run follows an edge */
+  uint8_t phantom_runs;                       /**< Consecutive runs with the line asserted and nothing to read */
+  uint16_t spurious;                          /**< Edges without motion in the current window */
+  uint32_t window_ms;                         /**< Start of the spurious edge window */
+  uint32_t fault_ms;                          /**< Uptime of the last fault */
+  uint32_t stuck_faults;                      /**< Faults for a line stuck asserted */
+  uint32_t storm_faults;                      /**< Faults for a line toggling without motion */
+  uint32_t phantoms;                          /**< Runs with the line asserted and nothing to read */
+  uint32_t spurious_edges;                    /**< Edges that found no motion */
+  uint32_t resets;                            /**< Sensor resets done to recover */
+  uint32_t reset_errors;                      /**< Recovery resets that failed */
+  uint32_t fallback_runs;                     /**< Motion work runs while the line was faulted */
+  uint32_t recoveries;                        /**< Faults cleared after the retry interval */
+};
+#endif
+
+#ifdef CONFIG_PAW3222_PIPELINE
+/**
+ * @brief Raw sample handed from the acquisition to the processing stage
+ */
+struct paw32xx_pipe_sample {
+  uint32_t cycles;                            /**< Cycle count when the X/Y read completed */
+  int16_t x;                                  /**< X delta, including carried overrun motion */
+  int16_t y;                                  /**< Y delta, including carried overrun motion */
+  uint8_t input_mode;                         /**< Input mode the CPI was switched to for this sample */
+};
+
+/**
+ * @brief Sample ring between the two pipeline stages of a device
+ *
+ * The motion work on the acquisition queue is the only producer and only
+ * writes head; the processing work on the system work queue is the only
+ * consumer and only writes tail. Neither side takes a lock.
+ */
+struct paw32xx_pipe {
+  struct paw32xx_pipe_sample ring[CONFIG_PAW3222_PIPELINE_DEPTH]; /**< Power-of-two sized */
+  atomic_t head;                              /**< Samples produced (free running) */
+  atomic_t tail;                              /**< Samples consumed (free running) */
+  int32_t carry_x;                            /**< Motion that found the ring full, added to the next sample */
+  int32_t carry_y;                            /**< Motion that found the ring full, added to the next sample */
+  uint32_t overruns;                          /**< Samples that found the ring full */
+  uint32_t depth_max;                         /**< Most samples waiting at once */
+  uint32_t wait_max_us;                       /**< Longest wait of a sample for processing, consumer only */
+  struct k_work work;                         /**< Processing stage */
+};
+#endif
+
 /**
  * @brief PAW3222 device configuration structure
  *
@@ -73,6 +414,8 @@ struct paw32xx_config {
   int32_t *scroll_horizontal_snipe_layers;     /**< Array of layer IDs for high-precision horizontal scroll */
   size_t bothscroll_layers_len;                /**< Number of XY simultaneous scroll layers defined */
   int32_t *bothscroll_layers;                   /**< Array of layer IDs for XY simultaneous scroll mode */
+  size_t cpi_profiles_len;                     /**< Number of additional CPI profiles defined */
+  int32_t *cpi_profiles;                       /**< CPI of profiles 1..n (profile 0 uses res_cpi) */
   
   /* Sensor configuration */
   int16_t res_cpi;                             /**< Default CPI resolution (608-4826) */
@@ -86,6 +429,16 @@ struct paw32xx_config {
 
   /* Mode switching configuration */
   enum paw32xx_mode_switch_method switch_method; /**< Method used for input mode switching */
+
+#ifdef CONFIG_PAW3222_RECORDER
+  struct paw32xx_rec_ring *rec_ring;           /**< Motion recording storage */
+#endif
+#ifdef CONFIG_PAW3222_SNAPSHOT
+  struct paw32xx_snapshot_area *snapshot;      /**< Retained snapshot storage */
+#endif
+#ifdef CONFIG_PAW3222_WARM_BOOT
+  struct paw32xx_warm *warm;                   /**< Retained warm boot marker */
+#endif
 };
 
 /**
@@ -104,17 +457,51 @@ struct paw32xx_data {
   struct gpio_callback motion_cb;             /**< GPIO callback for motion interrupt */
   struct k_timer motion_timer;                /**< Timer for motion processing timeout */
   int16_t current_cpi;                        /**< Currently configured CPI value */
-  int16_t scroll_accumulator;                 /**< Accumulator for smooth scrolling (reduced from int32_t) */
-  int16_t scroll_accumulator_x;               /**< X軸スクロール用 */
-  int16_t scroll_accumulator_y;               /**< Y軸スクロール用 */
+  struct paw32xx_core_state core;             /**< Scroll accumulators of the motion pipeline */
+  atomic_t core_reset;                        /**< Set to clear core before the next sample is processed */
 
   /* Mode switching state */
-  enum paw32xx_current_mode current_mode;     /**< Current operational mode of the sensor */
+  enum paw32xx_current_mode current_mode;     /**< Base (toggled) mode, effective when the mode stack is empty */
   bool mode_toggle_state;                     /**< Toggle state for behavior-based mode switching */
+  struct paw32xx_mode_stack_entry mode_stack[CONFIG_PAW3222_MODE_STACK_DEPTH]; /**< Momentary modes, top is effective */
+  uint8_t mode_stack_len;                     /**< Number of entries on the mode stack */
+  enum paw32xx_input_mode input_mode;         /**< Resolved input mode cached for the motion handler */
+  uint8_t profile;                            /**< Active profile index reported with mode changes */
+  struct paw32xx_tuning tune;                 /**< Live tunables used by the motion path */
+  struct k_work tune_work;                    /**< Applies changed tunables next to the motion work */
   /* Idle state support */
   struct k_timer idle_timer;                  /**< Idle timer for inactivity-based idle */
-  bool idle;                                  /**< True when driver is in idle state */
-  bool idle_timer_inited;                     /**< True when idle_timer has been initialized */
+  struct k_work idle_work;                    /**< Runs the idle timeout outside interrupt context */
+  struct paw32xx_idle_sm idle_sm;             /**< Idle / power state machine */
+  bool warm_boot;                             /**< Init adopted an already configured sensor */
+  uint32_t init_ms;                           /**< Time paw32xx_init() took */
+#ifdef CONFIG_PAW3222_SENSOR
+  struct paw32xx_sensor_state sensor;         /**< Sensor API / RTIO streaming state */
+#endif
+#ifdef CONFIG_PAW3222_STATS
+  struct paw32xx_stats stats;                 /**< Performance counters */
+#endif
+#ifdef CONFIG_PAW3222_LATENCY
+  struct paw32xx_latency latency;             /**< Motion pipeline latency histograms */
+#endif
+#ifdef CONFIG_PAW3222_TRACE
+  struct paw32xx_trace trace;                 /**< Hot-path trace ring buffer */
+#endif
+#ifdef CONFIG_PAW3222_CYCLE_STATS
+  struct paw32xx_cycle_stat cycles[PAW32XX_CYCLES_OP_COUNT]; /**< Cycle cost per operation */
+#endif
+#ifdef CONFIG_PAW3222_RECORDER
+  struct paw32xx_recorder recorder;           /**< Motion recorder state */
+#endif
+#ifdef CONFIG_PAW3222_SNAPSHOT
+  struct paw32xx_snapshot_state snapshot;     /**< Retained snapshot state */
+#endif
+#ifdef CONFIG_PAW3222_PIPELINE
+  struct paw32xx_pipe pipe;                   /**< Acquisition to processing sample ring */
+#endif
+#ifdef CONFIG_PAW3222_LINE_MONITOR
+  struct paw32xx_line line;                   /**< Motion line health */
+#endif
 };
 
 #endif /* ZEPHYR_INCLUDE_INPUT_PAW32XX_H_ */
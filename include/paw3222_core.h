@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_CORE_H_
+#define PAW3222_CORE_H_
+
+/**
+ * @file
+ * @brief Pure PAW3222 motion pipeline
+ *
+ * Sign extension, mode resolution, rotation, snipe division and scroll
+ * accumulation for one sensor sample, without any Zephyr or ZMK
+ * dependency. The driver feeds every sample through paw32xx_core_process()
+ * and reports the resulting events; tools/host builds the same code as the
+ * paw3222_core library for the replay, matrix and benchmark tools. New
+ * per-sample stages (filters, acceleration curves) belong here as well so
+ * that they can be profiled on the host.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Width of the DELTA_X / DELTA_Y registers in bits */
+#define PAW32XX_CORE_DATA_BITS 8
+
+/**
+ * @brief PAW3222 input mode enumeration
+ * 
+ * Defines the different operational modes for interpreting motion data
+ * from the PAW3222 sensor. Each mode affects how X/Y motion is processed
+ * and what type of input events are generated.
+ */
+enum paw32xx_input_mode {
+  PAW32XX_MOVE,                    /**< Standard cursor movement mode */
+  PAW32XX_SCROLL,                  /**< Vertical scroll mode - Y motion generates scroll wheel events */
+  PAW32XX_SCROLL_HORIZONTAL,       /**< Horizontal scroll mode - Y motion generates horizontal scroll events */
+  PAW32XX_SNIPE,                   /**< High-precision cursor movement mode with reduced sensitivity */
+  PAW32XX_SCROLL_SNIPE,            /**< High-precision vertical scroll mode with reduced sensitivity */
+  PAW32XX_SCROLL_HORIZONTAL_SNIPE, /**< High-precision horizontal scroll mode with reduced sensitivity */
+  PAW32XX_BOTHSCROLL,              /**< Simultaneous XY scroll mode (vertical + horizontal) */
+  PAW32XX_BOTHSCROLL_SNIPE,        /**< High-precision simultaneous XY scroll mode with reduced sensitivity */
+};
+
+/** @brief Number of entries in enum paw32xx_input_mode */
+#define PAW32XX_INPUT_MODE_COUNT (PAW32XX_BOTHSCROLL_SNIPE + 1)
+
+/**
+ * @brief Layers that select one input mode in layer switching
+ */
+struct paw32xx_core_layer_rule {
+  enum paw32xx_input_mode mode; /**< Mode selected by these layers */
+  const int32_t *layers;        /**< Layer IDs, may be NULL if len is 0 */
+  size_t len;                   /**< Number of layer IDs */
+};
+
+/**
+ * @brief Relative axes the pipeline reports on
+ */
+enum paw32xx_core_code {
+  PAW32XX_CORE_REL_X,      /**< Cursor X (INPUT_REL_X) */
+  PAW32XX_CORE_REL_Y,      /**< Cursor Y (INPUT_REL_Y) */
+  PAW32XX_CORE_REL_WHEEL,  /**< Vertical scroll (INPUT_REL_WHEEL) */
+  PAW32XX_CORE_REL_HWHEEL, /**< Horizontal scroll (INPUT_REL_HWHEEL) */
+};
+
+/** @brief Most events a single sample produces */
+#define PAW32XX_CORE_MAX_EVENTS 2
+
+/**
+ * @brief One relative input event
+ */
+struct paw32xx_core_event {
+  uint8_t code;  /**< enum paw32xx_core_code */
+  bool sync;     /**< Last event of the sample, which ends its report */
+  int16_t value; /**< Relative value */
+};
+
+/**
+ * @brief Events produced by one sample
+ */
+struct paw32xx_core_out {
+  uint8_t count;                                           /**< Number of events */
+  bool clamped;                                            /**< A scroll accumulator saturated */
+  struct paw32xx_core_event ev[PAW32XX_CORE_MAX_EVENTS];   /**< Events in report order */
+};
+
+/**
+ * @brief Pipeline parameters
+ */
+struct paw32xx_core_params {
+  uint16_t rotation;             /**< Sensor rotation in degrees (0, 90, 180, 270) */
+  uint8_t snipe_divisor;         /**< Cursor divisor in snipe mode */
+  uint8_t scroll_snipe_divisor;  /**< Scroll divisor in scroll snipe modes */
+  uint8_t scroll_tick;           /**< Scroll threshold in scroll modes */
+  uint8_t scroll_snipe_tick;     /**< Scroll threshold in scroll snipe modes */
+};
+
+/**
+ * @brief Pipeline state carried from one sample to the next
+ */
+struct paw32xx_core_state {
+  int16_t scroll_accumulator;   /**< Single axis scroll modes */
+  int16_t scroll_accumulator_x; /**< Horizontal axis of the XY scroll modes */
+  int16_t scroll_accumulator_y; /**< Vertical axis of the XY scroll modes */
+};
+
+/**
+ * @brief Sign-extend a raw delta register value
+ *
+ * @param raw DELTA_X or DELTA_Y register value (two's complement)
+ *
+ * @return Signed delta
+ */
+static inline int16_t paw32xx_core_sign_extend(uint8_t raw) {
+  const uint8_t sign = 1U << (PAW32XX_CORE_DATA_BITS - 1);
+
+  return (int16_t)((raw ^ sign) - sign);
+}
+
+/**
+ * @brief Map a behavior-selected mode to the input mode
+ *
+ * enum paw32xx_current_mode shares its ordering with enum
+ * paw32xx_input_mode; out-of-range values fall back to PAW32XX_MOVE.
+ *
+ * @param mode Behavior-selected mode
+ *
+ * @return Input mode
+ */
+enum paw32xx_input_mode paw32xx_core_behavior_mode(int mode);
+
+/**
+ * @brief Resolve the input mode for the active layer
+ *
+ * @param rules Layer rules in priority order, first match wins
+ * @param count Number of rules
+ * @param layer Highest active layer
+ *
+ * @return Mode of the first rule listing @p layer, PAW32XX_MOVE otherwise
+ */
+enum paw32xx_input_mode
+paw32xx_core_layer_mode(const struct paw32xx_core_layer_rule *rules,
+                        size_t count, uint8_t layer);
+
+/**
+ * @brief Calculate scroll Y coordinate based on sensor rotation
+ *
+ * Transforms the raw sensor coordinates to ensure that Y-axis movement
+ * always triggers scrolling regardless of the physical sensor orientation.
+ * This allows the sensor to be mounted at different angles while maintaining
+ * consistent scroll behavior.
+ *
+ * @param x Raw X coordinate from sensor
+ * @param y Raw Y coordinate from sensor
+ * @param rotation Physical sensor rotation in degrees (0, 90, 180, 270)
+ *
+ * @return Transformed Y coordinate for scroll calculations
+ *
+ * @note For cursor movement, use ZMK input-processors like zip_xy_transform
+ *       instead of this function. This is specifically for scroll modes.
+ *
+ * @note Handles INT16_MIN overflow case to prevent undefined behavior
+ *       when negating the minimum signed integer value.
+ */
+int16_t paw32xx_core_scroll_y(int16_t x, int16_t y, uint16_t rotation);
+
+/**
+ * @brief Drop partial scroll travel
+ *
+ * @param state Pipeline state
+ */
+void paw32xx_core_reset(struct paw32xx_core_state *state);
+
+/**
+ * @brief Run one sample through the pipeline
+ *
+ * @param params Pipeline parameters
+ * @param state Pipeline state, updated in place
+ * @param mode Input mode the sample is processed in
+ * @param x Raw X delta
+ * @param y Raw Y delta
+ * @param out Receives the events to report, in order; only the last one
+ *            is synced, so a sample is always one report
+ *
+ * @retval 0 Sample processed (out->count may be 0)
+ * @retval -EINVAL Unknown input mode
+ */
+int paw32xx_core_process(const struct paw32xx_core_params *params,
+                         struct paw32xx_core_state *state,
+                         enum paw32xx_input_mode mode, int16_t x, int16_t y,
+                         struct paw32xx_core_out *out);
+
+#endif /* PAW3222_CORE_H_ */
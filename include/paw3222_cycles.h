@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_CYCLES_H_
+#define PAW3222_CYCLES_H_
+
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+#ifdef CONFIG_PAW3222_CYCLE_STATS
+
+/**
+ * @brief Start measuring an operation
+ *
+ * @return Cycle count to pass to paw32xx_cycles_end()
+ */
+static inline uint32_t paw32xx_cycles_begin(void) { return k_cycle_get_32(); }
+
+/**
+ * @brief Finish measuring an operation and account its cost
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param op Measured operation (enum paw32xx_cycle_op)
+ * @param start Value returned by paw32xx_cycles_begin()
+ */
+void paw32xx_cycles_end(const struct device *dev, int op, uint32_t start);
+
+/**
+ * @brief Read the statistics of one operation
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param op Operation to read
+ * @param stat Receives the statistics
+ *
+ * @retval 0 Statistics copied
+ * @retval -EINVAL Invalid operation
+ */
+int paw32xx_cycles_get(const struct device *dev, enum paw32xx_cycle_op op,
+                       struct paw32xx_cycle_stat *stat);
+
+/**
+ * @brief Clear the statistics of all operations
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_cycles_reset(const struct device *dev);
+
+/**
+ * @brief Get the stable, machine-readable name of an operation
+ *
+ * @param op Operation
+ *
+ * @return Lower-case name such as "sample_move" or "cpi_switch"
+ */
+const char *paw32xx_cycles_op_name(enum paw32xx_cycle_op op);
+
+#else
+
+static inline uint32_t paw32xx_cycles_begin(void) { return 0; }
+
+static inline void paw32xx_cycles_end(const struct device *dev, int op,
+                                      uint32_t start) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(op);
+  ARG_UNUSED(start);
+}
+
+#endif /* CONFIG_PAW3222_CYCLE_STATS */
+
+#endif /* PAW3222_CYCLES_H_ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_EMUL_H_
+#define PAW3222_EMUL_H_
+
+#include <stdint.h>
+#include <zephyr/drivers/emul.h>
+
+/**
+ * @brief Motion source polled by the PAW3222 emulator
+ *
+ * Called every time the driver reads the MOTION register, i.e. once per
+ * emulated sensor frame. The source stores the motion of that frame in
+ * @p dx and @p dy (both preset to 0); returning 0/0 means no motion.
+ * It runs with the emulator lock held and must neither block nor call
+ * back into the emulator.
+ *
+ * @param target Emulator instance
+ * @param dx Receives the X motion of the frame
+ * @param dy Receives the Y motion of the frame
+ * @param user_data Pointer passed to paw32xx_emul_set_motion_source()
+ */
+typedef void (*paw32xx_emul_motion_source_t)(const struct emul *target,
+                                             int16_t *dx, int16_t *dy,
+                                             void *user_data);
+
+/**
+ * @brief Bus level counters of the PAW3222 emulator
+ */
+struct paw32xx_emul_stats {
+  uint32_t reg_reads;        /**< Register reads */
+  uint32_t reg_writes;       /**< Accepted register writes */
+  uint32_t blocked_writes;   /**< Writes dropped by write protection or to read-only registers */
+  uint32_t resets;           /**< Software resets */
+  uint32_t saturations;      /**< Motion counts lost to 8-bit delta saturation */
+  uint32_t irq_edges;        /**< Motion line assertions */
+  uint32_t storm_pulses;     /**< Motion line pulses forced by an IRQ storm */
+};
+
+/**
+ * @brief IRQ storm parameters
+ *
+ * While a storm runs, every MOTION read adds (@p dx, @p dy) on top of the
+ * motion source, so with large values the delta registers saturate on
+ * every frame. In addition the motion line is pulsed (released and
+ * asserted again) every @p irq_period_us regardless of whether the driver
+ * has read the pending motion yet.
+ */
+struct paw32xx_emul_storm {
+  int16_t dx;             /**< X motion added per frame and per pulse */
+  int16_t dy;             /**< Y motion added per frame and per pulse */
+  uint32_t irq_period_us; /**< Pulse period, 0 for no forced pulses */
+};
+
+/**
+ * @brief Install the programmable motion source
+ *
+ * @param target Emulator instance
+ * @param source Source to poll on every MOTION read, or NULL to remove it
+ * @param user_data Passed to @p source
+ */
+void paw32xx_emul_set_motion_source(const struct emul *target,
+                                    paw32xx_emul_motion_source_t source,
+                                    void *user_data);
+
+/**
+ * @brief Inject motion into the delta registers
+ *
+ * The motion is added to DELTA_X / DELTA_Y with 8-bit saturation and the
+ * motion line is asserted. Injected motion is dropped while the sensor is
+ * powered down (CONFIGURATION_PD_ENH set).
+ *
+ * @param target Emulator instance
+ * @param dx X motion
+ * @param dy Y motion
+ */
+void paw32xx_emul_add_motion(const struct emul *target, int16_t dx,
+                             int16_t dy);
+
+/**
+ * @brief Start an IRQ storm
+ *
+ * A storm already running is replaced.
+ *
+ * @param target Emulator instance
+ * @param storm Storm parameters, copied
+ */
+void paw32xx_emul_storm_start(const struct emul *target,
+                              const struct paw32xx_emul_storm *storm);
+
+/**
+ * @brief Stop the IRQ storm
+ *
+ * The motion already accumulated in the delta registers is kept.
+ *
+ * @param target Emulator instance
+ */
+void paw32xx_emul_storm_stop(const struct emul *target);
+
+/**
+ * @brief Read an emulated register without side effects
+ *
+ * @param target Emulator instance
+ * @param addr Register address
+ * @param val Receives the register value
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Address outside the register file
+ */
+int paw32xx_emul_reg_get(const struct emul *target, uint8_t addr, uint8_t *val);
+
+/**
+ * @brief Write an emulated register bypassing write protection
+ *
+ * @param target Emulator instance
+ * @param addr Register address
+ * @param val Value to store
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Address outside the register file
+ */
+int paw32xx_emul_reg_set(const struct emul *target, uint8_t addr, uint8_t val);
+
+/**
+ * @brief Copy the emulator counters
+ *
+ * @param target Emulator instance
+ * @param stats Receives the counters
+ */
+void paw32xx_emul_get_stats(const struct emul *target,
+                            struct paw32xx_emul_stats *stats);
+
+#endif /* PAW3222_EMUL_H_ */
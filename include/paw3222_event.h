@@ -0,0 +1,32 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_EVENT_H_
+#define PAW3222_EVENT_H_
+
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zmk/event_manager.h>
+
+#include "paw3222.h"
+
+/**
+ * @brief Raised whenever the effective input mode or profile of a PAW3222 changes
+ *
+ * The event is raised for both switching methods: behavior-driven mode
+ * changes and layer changes that resolve to a different mode. Listeners
+ * such as RGB underglow or display widgets can subscribe to it instead of
+ * polling the driver state.
+ */
+struct zmk_paw32xx_mode_changed {
+  const struct device *dev;           /**< PAW3222 instance whose mode changed */
+  enum paw32xx_current_mode mode;     /**< New effective mode */
+  uint8_t profile;                    /**< Active profile index */
+};
+
+ZMK_EVENT_DECLARE(zmk_paw32xx_mode_changed);
+
+#endif /* PAW3222_EVENT_H_ */
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_HID_H_
+#define PAW3222_HID_H_
+
+#include <stdbool.h>
+
+#include "paw3222_core.h"
+
+/*
+ * Direct HID report path.
+ *
+ * With CONFIG_PAW3222_HID_DIRECT the processed events of a sample are
+ * written into ZMK's pointing HID report and sent from the driver's own
+ * work item, instead of being queued to the input subsystem and turned
+ * into a report by a zmk,input-listener and its processors.
+ */
+
+/**
+ * @brief Send the events of one sample as one mouse report
+ *
+ * Cursor and wheel events are summed, saturated to the report fields and
+ * sent with one zmk_endpoints_send_mouse_report(); the movement and
+ * scroll fields are cleared again afterwards, as the input listener does.
+ *
+ * @param out Events of the sample
+ *
+ * @retval true A report was sent
+ * @retval false The sample produced no events
+ */
+bool paw32xx_hid_report(const struct paw32xx_core_out *out);
+
+#endif /* PAW3222_HID_H_ */
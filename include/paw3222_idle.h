@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_IDLE_H_
+#define PAW3222_IDLE_H_
+
+/**
+ * @file
+ * @brief PAW3222 idle / power state machine
+ *
+ * Decides, for every event that can change the idle state, which timers,
+ * interrupts, sensor sleep requests and work items the driver has to act
+ * on. It has no Zephyr dependency: the driver executes the returned
+ * actions (paw3222_input.c) and tools/host/paw3222_idle_sim drives the
+ * same code in virtual time to check that no wake is ever lost.
+ *
+ * Event sources in the driver:
+ *
+ *   PAW32XX_IDLE_EV_IRQ      motion line edge (interrupt context)
+ *   PAW32XX_IDLE_EV_POLL     motion timer expiry (interrupt context)
+ *   PAW32XX_IDLE_EV_RUN      motion work handler starts
+ *   PAW32XX_IDLE_EV_SAMPLE   motion work handler read a sample
+ *   PAW32XX_IDLE_EV_QUIET    motion work handler found no motion pending
+ *   PAW32XX_IDLE_EV_EXPIRE   idle timer expiry (interrupt context)
+ *   PAW32XX_IDLE_EV_TIMEOUT  idle timeout work, queued by EV_EXPIRE
+ *   PAW32XX_IDLE_EV_PHANTOM  motion work found the line asserted, nothing to read
+ *   PAW32XX_IDLE_EV_FAULT    motion line declared stuck or chattering
+ *   PAW32XX_IDLE_EV_CLEAR    motion line trusted again
+ *
+ * While the line is faulted the interrupt stays off and the motion timer
+ * polls at the fallback interval instead. In idle each poll is a probe:
+ * the sensor is woken for one read and put back to sleep unless it has
+ * motion, in which case the probe is the idle exit: the executor accounts
+ * for it when SAMPLE clears probe with idle still false.
+ *
+ * Events from interrupt context only ever return actions that are safe
+ * there; sensor sleep and wake requests (SPI) are only returned for
+ * events raised from the work queue.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Events fed to paw32xx_idle_step()
+ */
+enum paw32xx_idle_event {
+  PAW32XX_IDLE_EV_IRQ,     /**< Motion line edge */
+  PAW32XX_IDLE_EV_POLL,    /**< Motion timer expired */
+  PAW32XX_IDLE_EV_RUN,     /**< Motion work handler starts */
+  PAW32XX_IDLE_EV_SAMPLE,  /**< Motion sample read */
+  PAW32XX_IDLE_EV_QUIET,   /**< No motion pending */
+  PAW32XX_IDLE_EV_EXPIRE,  /**< Idle timer expired */
+  PAW32XX_IDLE_EV_TIMEOUT, /**< Idle timeout work runs */
+  PAW32XX_IDLE_EV_PHANTOM, /**< Line asserted without motion */
+  PAW32XX_IDLE_EV_FAULT,   /**< Motion line is not trusted */
+  PAW32XX_IDLE_EV_CLEAR,   /**< Motion line is trusted again */
+  PAW32XX_IDLE_EV_COUNT,
+};
+
+/**
+ * @name Actions returned by paw32xx_idle_step()
+ *
+ * Executed in the order listed here.
+ * @{
+ */
+#define PAW32XX_IDLE_ACT_IRQ_OFF (1U << 0)      /**< Disable the motion interrupt */
+#define PAW32XX_IDLE_ACT_POLL_STOP (1U << 1)    /**< Stop the motion timer */
+#define PAW32XX_IDLE_ACT_WAKE (1U << 2)         /**< Request sensor wake (leave idle) */
+#define PAW32XX_IDLE_ACT_SLEEP (1U << 3)        /**< Request sensor sleep (enter idle) */
+#define PAW32XX_IDLE_ACT_IRQ_ON (1U << 4)       /**< Enable the motion interrupt (edge to active) */
+#define PAW32XX_IDLE_ACT_POLL (1U << 5)         /**< Start the motion timer with the normal interval */
+#define PAW32XX_IDLE_ACT_POLL_REDUCED (1U << 6) /**< Start the motion timer with the reduced-scan interval */
+#define PAW32XX_IDLE_ACT_ARM_TIMEOUT (1U << 7)  /**< Restart the idle timeout */
+#define PAW32XX_IDLE_ACT_RUN (1U << 8)          /**< Submit the motion work */
+#define PAW32XX_IDLE_ACT_RECHECK (1U << 9)      /**< Submit the motion work if the line is already asserted */
+#define PAW32XX_IDLE_ACT_TIMEOUT_WORK (1U << 10) /**< Submit the idle timeout work */
+#define PAW32XX_IDLE_ACT_POLL_FALLBACK (1U << 11) /**< Start the motion timer with the fallback interval (active or idle) */
+/** @} */
+
+/**
+ * @brief Idle state machine
+ */
+struct paw32xx_idle_sm {
+  bool idle;         /**< Sensor asleep, waiting for an edge */
+  bool expired;      /**< Idle timer expired and was not re-armed since */
+  bool reduced_scan; /**< First poll after a wake uses the reduced-scan interval */
+  bool fault;        /**< Motion line not trusted: interrupt off, fallback polling */
+  bool probe;        /**< Woken from idle by a fallback poll, not by motion */
+  bool woke;         /**< Woken from idle and no sample processed since */
+};
+
+/**
+ * @brief Initialize the state machine in the active state
+ *
+ * @param sm State machine
+ * @param reduced_scan Use the reduced-scan interval for the first poll
+ *                     after a wake (CONFIG_PAW3222_REDUCED_SCAN)
+ */
+void paw32xx_idle_init(struct paw32xx_idle_sm *sm, bool reduced_scan);
+
+/**
+ * @brief Feed one event to the state machine
+ *
+ * @param sm State machine
+ * @param ev Event
+ *
+ * @return PAW32XX_IDLE_ACT_* bit mask of the actions to execute
+ */
+uint16_t paw32xx_idle_step(struct paw32xx_idle_sm *sm,
+                           enum paw32xx_idle_event ev);
+
+#endif /* PAW3222_IDLE_H_ */
@@ -13,6 +13,7 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 
+#include "paw3222.h"
 #include "paw3222_regs.h"
 
 /**
@@ -31,14 +32,214 @@
  * @retval PAW32XX_SNIPE High-precision cursor mode
  * @retval PAW32XX_SCROLL_SNIPE High-precision vertical scroll mode
  * @retval PAW32XX_SCROLL_HORIZONTAL_SNIPE High-precision horizontal scroll mode
+ * @retval PAW32XX_BOTHSCROLL Simultaneous XY scroll mode
+ * @retval PAW32XX_BOTHSCROLL_SNIPE High-precision simultaneous XY scroll mode
  * 
- * @note This function is called during motion processing to determine how
- *       to interpret sensor data. The behavior depends on the switch_method
- *       configured in the device tree.
+ * @note This function is called when the mode or the active layer changes;
+ *       the result is cached in paw32xx_data::input_mode for the motion
+ *       handler. The behavior depends on the switch_method configured in
+ *       the device tree.
  */
 enum paw32xx_input_mode
 get_input_mode_for_current_layer(const struct device *dev);
 
+/**
+ * @brief Get the effective behavior-selected mode
+ *
+ * Returns the mode on top of the mode stack, or the base (toggled) mode
+ * when no momentary binding is held.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @return Effective mode
+ */
+enum paw32xx_current_mode paw32xx_mode_effective(const struct device *dev);
+
+/**
+ * @brief Replace the effective behavior-selected mode
+ *
+ * Toggles act on the effective mode: while momentary bindings are held the
+ * top stack entry is replaced, otherwise the base mode is.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param mode New effective mode
+ */
+void paw32xx_mode_set_effective(const struct device *dev,
+                                enum paw32xx_current_mode mode);
+
+/**
+ * @brief Push a momentary mode onto the mode stack
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param mode Mode that becomes effective
+ * @param position Key position of the binding, used to pop it again
+ *
+ * @return 0 on success, negative error code on failure
+ * @retval -ENOMEM Stack is full (CONFIG_PAW3222_MODE_STACK_DEPTH)
+ *
+ * @note The cached input mode is not updated; call
+ *       paw32xx_update_effective_mode() afterwards.
+ */
+int paw32xx_mode_push(const struct device *dev, enum paw32xx_current_mode mode,
+                      uint32_t position);
+
+/**
+ * @brief Remove the momentary mode pushed by a key position
+ *
+ * The entry is removed wherever it is in the stack, so overlapping holds
+ * can be released in any order.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param position Key position passed to paw32xx_mode_push()
+ *
+ * @return 0 on success, negative error code on failure
+ * @retval -ENOENT No entry for this position
+ *
+ * @note The cached input mode is not updated; call
+ *       paw32xx_update_effective_mode() afterwards.
+ */
+int paw32xx_mode_pop(const struct device *dev, uint32_t position);
+
+/**
+ * @brief Re-resolve the effective mode and publish it if it changed
+ *
+ * Resolves the current input mode (from the behavior state or the active
+ * layer, depending on the switch method), caches it for the motion handler
+ * and raises a zmk_paw32xx_mode_changed event when it differs from the
+ * previously cached mode.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @note Called on behavior mode changes and on ZMK layer state changes.
+ */
+void paw32xx_update_effective_mode(const struct device *dev);
+
+/**
+ * @brief Select the active CPI profile
+ *
+ * Profile 0 uses res-cpi; profile n (n >= 1) uses entry n - 1 of the
+ * cpi-profiles devicetree array. The profile CPI applies to all non-snipe
+ * modes. A zmk_paw32xx_mode_changed event is raised and the new CPI is
+ * written from the queue of the motion work, see paw32xx_apply_mode().
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param profile Profile index
+ *
+ * @return 0 on success, negative error code on failure
+ * @retval -EINVAL Profile index is not configured
+ */
+int paw32xx_set_profile(const struct device *dev, uint8_t profile);
+
+/**
+ * @brief Prepare the motion pipeline for a freshly switched mode
+ *
+ * Has the processing stage clear all scroll accumulators before its next
+ * sample and queues the CPI required by the current mode ahead of the next
+ * motion read, so the first motion sample after a mode switch is already
+ * processed with the correct sensitivity and without leftover scroll
+ * travel. Safe to call from any thread.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @note The CPI is written by tune_work on the queue of the motion work,
+ *       never from the caller's thread, and not before an idle sensor
+ *       wakes up.
+ */
+void paw32xx_apply_mode(const struct device *dev);
+
+/**
+ * @brief Get the printable name of a mode
+ *
+ * @param mode Mode to name
+ *
+ * @return Upper-case mode name, or "UNKNOWN" for out-of-range values
+ */
+const char *paw32xx_mode_name(enum paw32xx_current_mode mode);
+
+/**
+ * @brief Seed the runtime tunables from the device configuration
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @note Called once during device initialization.
+ */
+void paw32xx_tuning_init(const struct device *dev);
+
+/**
+ * @brief Work handler applying changed tunables
+ *
+ * Writes the CPI of the current mode and profile if a mode, profile or
+ * tunable change requires it. Submitted to the queue of the motion work,
+ * so it is serialized with the motion work handler. Does nothing while
+ * the sensor is idle; the wake writes the CPI instead.
+ *
+ * @param work Work item (tune_work of struct paw32xx_data)
+ */
+void paw32xx_tuning_work_handler(struct k_work *work);
+
+/**
+ * @brief Function run by paw32xx_queue_call()
+ *
+ * @param dev PAW3222 device pointer
+ * @param arg Argument passed to paw32xx_queue_call()
+ *
+ * @return Passed back to the caller of paw32xx_queue_call()
+ */
+typedef int (*paw32xx_queue_fn_t)(const struct device *dev, void *arg);
+
+/**
+ * @brief Run a function on the queue of the motion work and wait for it
+ *
+ * Register sequences issued from other threads, such as the shell, go
+ * through here so they never interleave with a motion read. Called from
+ * that queue itself, the function runs directly.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param fn Function to run
+ * @param arg Passed to @p fn
+ *
+ * @return Result of @p fn, or a negative error code if it could not be
+ *         queued
+ *
+ * @note Blocks; must not be called from interrupt context.
+ */
+int paw32xx_queue_call(const struct device *dev, paw32xx_queue_fn_t fn,
+                       void *arg);
+
+/**
+ * @brief Reset and reconfigure the sensor at runtime
+ *
+ * Stops motion processing, runs paw32xx_configure() again and re-applies
+ * the CPI of the current mode and profile from the runtime tunables. The
+ * processing stage drops its scroll accumulators before the next sample.
+ * The motion interrupt is re-armed even if reconfiguration fails. Runs
+ * on the queue of the motion work through paw32xx_queue_call(), so it
+ * never overlaps a motion read; the line monitor calls it from the motion
+ * work itself.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @return 0 on success, negative error code from paw32xx_configure()
+ */
+int paw32xx_reinit(const struct device *dev);
+
+#ifdef CONFIG_PAW3222_STATS
+/**
+ * @brief Clear the performance counters
+ *
+ * Runs on the queue of the motion work through paw32xx_queue_call(), so
+ * the counters are not cleared under a running motion work handler. The
+ * bookkeeping of a work submission in flight is kept. With the pipeline
+ * the ring counters are cleared as well.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @return 0 on success, negative error code if the reset could not be
+ *         queued
+ */
+int paw32xx_stats_reset(const struct device *dev);
+#endif
+
 #ifdef CONFIG_PAW3222_BEHAVIOR
 /**
  * @brief Set the PAW3222 device reference for behavior-based mode switching
@@ -97,6 +298,22 @@ void paw32xx_motion_timer_handler(struct k_timer *timer);
  */
 void paw32xx_motion_work_handler(struct k_work *work);
 
+/**
+ * @brief Transform and report one sample
+ *
+ * The processing half of the motion path: runs the sample through
+ * paw32xx_core_process() and reports the resulting events. Called by the
+ * motion work, or by the processing work of CONFIG_PAW3222_PIPELINE.
+ *
+ * @param dev PAW3222 device pointer
+ * @param x Raw X delta
+ * @param y Raw Y delta
+ * @param input_mode Input mode the sample was read in
+ * @param cyc Cycle count the per-sample cost is accounted from
+ */
+void paw32xx_process_sample(const struct device *dev, int16_t x, int16_t y,
+                            enum paw32xx_input_mode input_mode, uint32_t cyc);
+
 /**
  * @brief GPIO interrupt handler for motion detection
  *
@@ -130,12 +347,39 @@ void paw32xx_motion_handler(const struct device *gpio_dev,
 #ifndef CONFIG_PAW3222_REDUCED_SCAN_MS
 #define CONFIG_PAW3222_REDUCED_SCAN_MS 100
 #endif
+/* Motion line fallback polling (used if Kconfig not present) */
+#ifndef CONFIG_PAW3222_LINE_FALLBACK_MS
+#define CONFIG_PAW3222_LINE_FALLBACK_MS 20
+#endif
+#ifndef CONFIG_PAW3222_LINE_FALLBACK_IDLE_MS
+#define CONFIG_PAW3222_LINE_FALLBACK_IDLE_MS 500
+#endif
 /* Power control fallback (used if Kconfig not present) */
 #ifndef CONFIG_PAW3222_POWER_CTRL
 #define CONFIG_PAW3222_POWER_CTRL 0
 #endif
+/**
+ * @brief Feed an event to the idle state machine and execute its actions
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param ev Event, see paw3222_idle.h for where each one is raised
+ *
+ * @note PAW32XX_IDLE_EV_IRQ, PAW32XX_IDLE_EV_POLL and PAW32XX_IDLE_EV_EXPIRE
+ *       may be raised from interrupt context, all other events only from
+ *       the motion work's queue (paw32xx_pipeline_queue()).
+ */
+void paw32xx_idle_event(const struct device *dev, enum paw32xx_idle_event ev);
+
 void paw32xx_idle_timeout_handler(struct k_timer *timer);
-void paw32xx_idle_enter(const struct device *dev);
-void paw32xx_idle_exit(const struct device *dev);
+
+/**
+ * @brief Idle timeout work handler
+ *
+ * Raises PAW32XX_IDLE_EV_TIMEOUT on the motion work's queue
+ * (paw32xx_pipeline_queue()), where it is serialized with the motion work.
+ *
+ * @param work Work item (idle_work in struct paw32xx_data)
+ */
+void paw32xx_idle_work_handler(struct k_work *work);
 
 #endif /* PAW3222_INPUT_H_ */
\ No newline at end of file
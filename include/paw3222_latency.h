@@ -0,0 +1,204 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_LATENCY_H_
+#define PAW3222_LATENCY_H_
+
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+#ifdef CONFIG_PAW3222_LATENCY
+
+/** @brief A motion IRQ was seen and its X/Y read has not completed yet */
+#define PAW32XX_LATENCY_PENDING_IRQ BIT(0)
+/** @brief An X/Y read completed and no report has been synced for it yet */
+#define PAW32XX_LATENCY_PENDING_SPI BIT(1)
+/** @brief The pending X/Y read was triggered by a motion IRQ */
+#define PAW32XX_LATENCY_PENDING_IRQ_SPI BIT(2)
+
+/**
+ * @brief Add one latency to a stage histogram
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param stage Pipeline stage the latency belongs to
+ * @param cycles Latency in hardware cycles
+ */
+void paw32xx_latency_record(const struct device *dev,
+                            enum paw32xx_latency_stage stage, uint32_t cycles);
+
+/**
+ * @brief Read a stage histogram
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param stage Pipeline stage to read
+ * @param buckets Receives PAW32XX_LATENCY_BUCKETS sample counts
+ * @param max_us Receives the largest latency seen, may be NULL
+ *
+ * @retval 0 Histogram copied
+ * @retval -EINVAL Invalid stage
+ */
+int paw32xx_latency_get(const struct device *dev,
+                        enum paw32xx_latency_stage stage,
+                        uint32_t buckets[PAW32XX_LATENCY_BUCKETS],
+                        uint32_t *max_us);
+
+/**
+ * @brief Clear all latency histograms of a device
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_latency_reset(const struct device *dev);
+
+/**
+ * @brief Timestamp a motion IRQ edge
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @note Called from the GPIO ISR; only stores a cycle count.
+ */
+static inline void paw32xx_latency_mark_irq(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  data->latency.irq_cyc = k_cycle_get_32();
+  atomic_or(&data->latency.pending, PAW32XX_LATENCY_PENDING_IRQ);
+}
+
+/**
+ * @brief Timestamp completion of the X/Y register read
+ *
+ * Records the IRQ-to-SPI latency when the read was triggered by an IRQ
+ * rather than by the polling timer.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+static inline void paw32xx_latency_mark_spi(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  atomic_val_t pending;
+
+  data->latency.spi_cyc = k_cycle_get_32();
+
+  /* The ISR may set the IRQ flag at any time, so swap it out atomically */
+  do {
+    pending = atomic_get(&data->latency.pending);
+  } while (!atomic_cas(&data->latency.pending, pending,
+                       (pending & PAW32XX_LATENCY_PENDING_IRQ)
+                           ? PAW32XX_LATENCY_PENDING_SPI |
+                                 PAW32XX_LATENCY_PENDING_IRQ_SPI
+                           : PAW32XX_LATENCY_PENDING_SPI));
+
+  if (pending & PAW32XX_LATENCY_PENDING_IRQ) {
+    paw32xx_latency_record(dev, PAW32XX_LATENCY_IRQ_TO_SPI,
+                           data->latency.spi_cyc - data->latency.irq_cyc);
+  }
+}
+
+/**
+ * @brief Note a synced report about to be handed on
+ *
+ * Called before the report is queued, so the HID side can never see it
+ * first. Only the oldest report not yet seen by the HID side is tracked;
+ * reports queued behind it are not measured.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+static inline void paw32xx_latency_mark_sync(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  if (!(atomic_get(&data->latency.pending) & PAW32XX_LATENCY_PENDING_SPI) ||
+      atomic_get(&data->latency.hid_pending) != 0) {
+    return;
+  }
+
+  data->latency.hid_cyc = data->latency.spi_cyc;
+  atomic_set(&data->latency.hid_pending, 1);
+}
+
+/**
+ * @brief Timestamp a report reaching the HID side
+ *
+ * With CONFIG_PAW3222_HID_DIRECT that is the return of the HID send.
+ * Otherwise the driver's input callback calls it when the input subsystem
+ * delivers the synced event to the listeners, which includes the hop to
+ * the input thread.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+static inline void paw32xx_latency_mark_hid(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  if (!atomic_cas(&data->latency.hid_pending, 1, 0)) {
+    return;
+  }
+
+  paw32xx_latency_record(dev, PAW32XX_LATENCY_SPI_TO_HID,
+                         k_cycle_get_32() - data->latency.hid_cyc);
+}
+
+/**
+ * @brief Timestamp a synced input report
+ *
+ * A sample ends in at most one synced report; a report without a new X/Y
+ * read is not measured.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+static inline void paw32xx_latency_mark_report(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  atomic_val_t pending;
+  uint32_t now;
+
+  /* Clear only the SPI flags; an IRQ seen meanwhile must stay pending */
+  do {
+    pending = atomic_get(&data->latency.pending);
+    if (!(pending & PAW32XX_LATENCY_PENDING_SPI)) {
+      return;
+    }
+  } while (!atomic_cas(&data->latency.pending, pending,
+                       pending & PAW32XX_LATENCY_PENDING_IRQ));
+
+  now = k_cycle_get_32();
+  paw32xx_latency_record(dev, PAW32XX_LATENCY_SPI_TO_REPORT,
+                         now - data->latency.spi_cyc);
+  if (pending & PAW32XX_LATENCY_PENDING_IRQ_SPI) {
+    paw32xx_latency_record(dev, PAW32XX_LATENCY_IRQ_TO_REPORT,
+                           now - data->latency.irq_cyc);
+  }
+}
+
+/* Without the direct path the HID side is seen from an input callback */
+#ifndef CONFIG_PAW3222_HID_DIRECT
+#define PAW32XX_LATENCY_INPUT_HOP 1
+#endif
+
+#else
+
+static inline void paw32xx_latency_mark_irq(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_latency_mark_spi(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_latency_mark_report(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_latency_mark_sync(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_latency_mark_hid(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+#endif /* CONFIG_PAW3222_LATENCY */
+
+#endif /* PAW3222_LATENCY_H_ */
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_LINE_H_
+#define PAW3222_LINE_H_
+
+#include <stdbool.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_idle.h"
+#include "paw3222_input.h"
+
+/*
+ * Motion line monitor.
+ *
+ * The motion work reports what each run found; the monitor declares the
+ * line faulted when it stays asserted with nothing to read for
+ * CONFIG_PAW3222_LINE_STUCK_RUNS runs, or when edges without motion reach
+ * CONFIG_PAW3222_LINE_SPURIOUS_PER_S. A fault resets the sensor and hands
+ * the idle state machine over to fallback polling; the line is trusted
+ * again once it is released and CONFIG_PAW3222_LINE_RETRY_S has passed.
+ */
+
+#ifdef CONFIG_PAW3222_LINE_MONITOR
+
+/**
+ * @brief Note a motion line edge
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @note Called from the GPIO ISR.
+ */
+static inline void paw32xx_line_edge(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  atomic_set(&data->line.edge, 1);
+}
+
+/**
+ * @brief Reset the monitor of a device
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_line_init(const struct device *dev);
+
+/**
+ * @brief Start of a motion work run
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_line_run(const struct device *dev);
+
+/**
+ * @brief The run found no motion and the line released
+ *
+ * Counts the run as a spurious edge if an edge triggered it.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_line_quiet(const struct device *dev);
+
+/**
+ * @brief The run found the line asserted but no motion and zero deltas
+ *
+ * Feeds PAW32XX_IDLE_EV_PHANTOM, or declares the line stuck.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @retval true The run is finished; the sample must not be processed
+ */
+bool paw32xx_line_phantom(const struct device *dev);
+
+/**
+ * @brief The run read a sample with motion
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_line_sample(const struct device *dev);
+
+/**
+ * @brief The run found no motion while the line is faulted
+ *
+ * Feeds PAW32XX_IDLE_EV_CLEAR if the line may be trusted again, otherwise
+ * PAW32XX_IDLE_EV_QUIET to keep polling.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_line_fault_quiet(const struct device *dev);
+
+#else
+
+static inline void paw32xx_line_edge(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_line_init(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_line_run(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_line_quiet(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline bool paw32xx_line_phantom(const struct device *dev) {
+  ARG_UNUSED(dev);
+  return false;
+}
+
+static inline void paw32xx_line_sample(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+/* Unreachable: nothing declares a fault without the monitor */
+static inline void paw32xx_line_fault_quiet(const struct device *dev) {
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_QUIET);
+}
+
+#endif /* CONFIG_PAW3222_LINE_MONITOR */
+
+#endif /* PAW3222_LINE_H_ */
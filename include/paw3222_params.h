@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_PARAMS_H_
+#define PAW3222_PARAMS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/**
+ * @brief Runtime tunables, in the order of the parameter table
+ *
+ * The numbering is part of the RPC protocol: append new entries, never
+ * reorder them.
+ */
+enum paw32xx_param_id {
+  PAW32XX_PARAM_CPI,
+  PAW32XX_PARAM_SNIPE_CPI,
+  PAW32XX_PARAM_SNIPE_DIVISOR,
+  PAW32XX_PARAM_SCROLL_SNIPE_DIVISOR,
+  PAW32XX_PARAM_SCROLL_TICK,
+  PAW32XX_PARAM_SCROLL_SNIPE_TICK,
+  PAW32XX_PARAM_POLL_MS,
+  PAW32XX_PARAM_REDUCED_SCAN_MS,
+  PAW32XX_PARAM_IDLE_TIMEOUT_S,
+  PAW32XX_PARAM_COUNT,
+};
+
+/**
+ * @brief Description of one tunable
+ *
+ * Each entry describes one field of struct paw32xx_tuning together with
+ * its accepted range.
+ */
+struct paw32xx_param {
+  const char *name;
+  size_t offset;
+  uint8_t size;
+  int32_t min;
+  int32_t max;
+};
+
+/**
+ * @brief Get the description of a tunable
+ *
+ * @param id Parameter id
+ *
+ * @return Description, or NULL if id is out of range
+ */
+const struct paw32xx_param *paw32xx_param_at(unsigned int id);
+
+/**
+ * @brief Look up a tunable by name
+ *
+ * @param name Parameter name as listed by "paw3222 state"
+ *
+ * @return Parameter id, or -EINVAL if there is no such parameter
+ */
+int paw32xx_param_find(const char *name);
+
+/**
+ * @brief Read the current value of a tunable
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param id Parameter id
+ * @param value Receives the value
+ *
+ * @retval 0 Value read
+ * @retval -EINVAL Unknown parameter id
+ */
+int paw32xx_param_get(const struct device *dev, unsigned int id,
+                      int32_t *value);
+
+/**
+ * @brief Change a tunable at runtime
+ *
+ * The field is updated at once and picked up by the next motion sample,
+ * poll or idle timer start. A changed CPI is written to the sensor from
+ * the work queue of the motion work, after any motion work already
+ * queued and without waking the sensor from idle.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param id Parameter id
+ * @param value New value
+ *
+ * @retval 0 Value applied
+ * @retval -EINVAL Unknown parameter id or value out of range
+ */
+int paw32xx_param_set(const struct device *dev, unsigned int id,
+                      int32_t value);
+
+#endif /* PAW3222_PARAMS_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_PIPELINE_H_
+#define PAW3222_PIPELINE_H_
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+#ifdef CONFIG_PAW3222_PIPELINE
+
+/**
+ * @brief Set up the sample ring of a device
+ *
+ * Starts the shared acquisition work queue on the first call.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_pipeline_init(const struct device *dev);
+
+/**
+ * @brief Get the work queue of the motion work
+ *
+ * @return The shared acquisition queue
+ */
+struct k_work_q *paw32xx_pipeline_queue(void);
+
+/**
+ * @brief Queue work that talks to the sensor
+ *
+ * Motion, idle and tuning work all go to the acquisition queue so that
+ * register sequences of one device never interleave.
+ *
+ * @param work Work item to submit
+ */
+void paw32xx_pipeline_submit(struct k_work *work);
+
+/**
+ * @brief Hand one sample from acquisition to processing
+ *
+ * Called by the motion work only. If the ring is full the sample is
+ * counted as an overrun and its motion is added to the next sample that
+ * fits, so no travel is lost while input delivery is slow.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param x Raw X delta
+ * @param y Raw Y delta
+ * @param input_mode Input mode the CPI was switched to for this sample
+ */
+void paw32xx_pipeline_push(const struct device *dev, int16_t x, int16_t y,
+                           enum paw32xx_input_mode input_mode);
+
+/**
+ * @brief Hand over motion carried from overruns
+ *
+ * Called by the motion work when motion stops, so travel carried from a
+ * full ring is not held back until the next movement.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_pipeline_flush(const struct device *dev);
+
+/**
+ * @brief Get the ring counters of a device
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param overruns Receives the number of samples that found the ring full
+ * @param depth_max Receives the most samples that were waiting at once
+ * @param wait_max_us Receives the longest time a sample waited for
+ *        processing
+ */
+void paw32xx_pipeline_get(const struct device *dev, uint32_t *overruns,
+                          uint32_t *depth_max, uint32_t *wait_max_us);
+
+/**
+ * @brief Clear the ring counters of a device
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_pipeline_reset(const struct device *dev);
+
+#else
+
+static inline void paw32xx_pipeline_init(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline struct k_work_q *paw32xx_pipeline_queue(void) {
+  return &k_sys_work_q;
+}
+
+static inline void paw32xx_pipeline_submit(struct k_work *work) {
+  k_work_submit(work);
+}
+
+static inline void paw32xx_pipeline_flush(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+#endif /* CONFIG_PAW3222_PIPELINE */
+
+#endif /* PAW3222_PIPELINE_H_ */
@@ -9,10 +9,12 @@
 #ifndef PAW3222_POWER_H_
 #define PAW3222_POWER_H_
 
+#include <errno.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <zephyr/device.h>
 #include <zephyr/pm/device.h>
+#include <zephyr/sys/util.h>
 
 /**
  * @brief Configure and initialize the PAW3222 sensor
@@ -40,6 +42,58 @@
  */
 int paw32xx_configure(const struct device *dev);
 
+#ifdef CONFIG_PAW3222_WARM_BOOT
+/**
+ * @brief Adopt a sensor that a previous boot configured
+ *
+ * The warm boot counterpart of paw32xx_configure(): verifies the product
+ * ID and that the sensor is neither resetting nor powered down, then
+ * compares the CPI and sleep mode registers with the configuration and
+ * rewrites only those that differ. No reset, no reset delay.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @retval 0 Sensor adopted
+ * @retval -ENODEV The sensor is not in a configured state
+ * @retval -EINVAL Invalid configuration parameters
+ * @retval -EIO SPI communication failure
+ */
+int paw32xx_configure_warm(const struct device *dev);
+
+/**
+ * @brief Check the warm boot marker
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ *
+ * @retval true The previous boot left the sensor configured
+ */
+bool paw32xx_warm_valid(const struct device *dev);
+
+/**
+ * @brief Set or clear the warm boot marker
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param configured True once the sensor holds the configuration
+ */
+void paw32xx_warm_mark(const struct device *dev, bool configured);
+#else
+static inline int paw32xx_configure_warm(const struct device *dev) {
+  ARG_UNUSED(dev);
+  return -ENODEV;
+}
+
+static inline bool paw32xx_warm_valid(const struct device *dev) {
+  ARG_UNUSED(dev);
+  return false;
+}
+
+static inline void paw32xx_warm_mark(const struct device *dev,
+                                     bool configured) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(configured);
+}
+#endif
+
 /**
  * @brief Set CPI resolution on a PAW3222 device
  *
@@ -127,4 +181,20 @@ int paw32xx_force_awake(const struct device *dev, bool enable);
 int paw32xx_pm_action(const struct device *dev, enum pm_device_action action);
 #endif
 
+/**
+ * @brief Put the sensor to sleep or wake it up (board hook)
+ *
+ * Called on idle entry and exit when CONFIG_PAW3222_POWER_CTRL is enabled,
+ * always from the motion work's queue (paw32xx_pipeline_queue()): the
+ * system work queue, or the acquisition queue with CONFIG_PAW3222_PIPELINE.
+ * paw3222_power.c provides a weak default that only logs; boards with a
+ * power control mechanism override it.
+ *
+ * @param dev PAW3222 device pointer
+ * @param sleep True to enter the low-power state, false to wake
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int paw3222_set_sleep(const struct device *dev, bool sleep);
+
 #endif /* PAW3222_POWER_H_ */
\ No newline at end of file
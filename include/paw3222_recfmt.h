@@ -0,0 +1,265 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_RECFMT_H_
+#define PAW3222_RECFMT_H_
+
+/**
+ * @file
+ * @brief PAW3222 motion recording format, version 1
+ *
+ * This header has no Zephyr dependencies so that host tools can decode
+ * dumps with the same code the driver encodes them with. All multi-byte
+ * fields are little-endian.
+ *
+ * A recording is a ring header followed by block_count fixed size blocks:
+ *
+ *   Ring header (12 bytes)
+ *     0  u32 magic        PAW32XX_REC_MAGIC ("PAWR")
+ *     4  u8  version      PAW32XX_REC_VERSION
+ *     5  u8  boot         Incremented on every boot that kept the ring
+ *     6  u16 block_size   PAW32XX_REC_BLOCK_SIZE
+ *     8  u16 block_count  Power of two
+ *     10 u16 next_seq     Sequence number the next block will get
+ *
+ *   Block (block_size bytes), stored at index seq % block_count
+ *     0  u32 t0_us        Uptime of the first sample in microseconds
+ *     4  u16 seq          Block sequence number
+ *     6  u8  boot         Ring header boot count when the block was opened
+ *     7  u8  used         Payload bytes in use, 0 for an empty block
+ *     8  payload          Samples, see below
+ *
+ * Each sample is a flags byte followed by three varints:
+ *
+ *   flags  bits 0-3 input mode (enum paw32xx_input_mode), bit 4 motion
+ *          status MOT, bit 5 DXOVF, bit 6 DYOVF, bit 7 reserved (zero)
+ *   dt     unsigned LEB128, microseconds since the previous sample of the
+ *          block (0 for the first one)
+ *   dx     zigzag LEB128, raw X minus the raw X of the previous sample of
+ *          the block (previous is 0 for the first one)
+ *   dy     zigzag LEB128, same for Y
+ *
+ * Blocks are self-contained, so a block overwritten by the ring never
+ * affects the decoding of the others. Readers order the blocks by seq
+ * (modulo 2^16, counting back from next_seq) and must reject versions
+ * they do not know.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PAW32XX_REC_MAGIC 0x52574150U /**< "PAWR" read as a little-endian u32 */
+#define PAW32XX_REC_VERSION 1
+#define PAW32XX_REC_BLOCK_SIZE 64
+#define PAW32XX_REC_RING_HDR_SIZE 12
+#define PAW32XX_REC_BLOCK_HDR_SIZE 8
+#define PAW32XX_REC_PAYLOAD_SIZE                                               \
+  (PAW32XX_REC_BLOCK_SIZE - PAW32XX_REC_BLOCK_HDR_SIZE)
+#define PAW32XX_REC_SAMPLE_MAX 12 /**< flags + 5 byte dt + 2 x 3 byte deltas */
+
+#define PAW32XX_REC_FLAG_MODE_MASK 0x0f
+#define PAW32XX_REC_FLAG_MOT 0x10
+#define PAW32XX_REC_FLAG_DXOVF 0x20
+#define PAW32XX_REC_FLAG_DYOVF 0x40
+#define PAW32XX_REC_FLAG_RESERVED 0x80
+
+/**
+ * @brief Ring header, laid out exactly as stored
+ */
+struct paw32xx_rec_ring_hdr {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t boot;
+  uint16_t block_size;
+  uint16_t block_count;
+  uint16_t next_seq;
+};
+
+/**
+ * @brief Block header, laid out exactly as stored
+ */
+struct paw32xx_rec_block_hdr {
+  uint32_t t0_us;
+  uint16_t seq;
+  uint8_t boot;
+  uint8_t used;
+};
+
+/**
+ * @brief One decoded sample
+ */
+struct paw32xx_rec_sample {
+  uint32_t t_us; /**< Uptime in microseconds */
+  int16_t x;     /**< Raw X delta read from the sensor */
+  int16_t y;     /**< Raw Y delta read from the sensor */
+  uint8_t flags; /**< Mode and status flags */
+};
+
+/**
+ * @brief Decoding state for the samples of one block
+ */
+struct paw32xx_rec_cursor {
+  const uint8_t *p;
+  const uint8_t *end;
+  struct paw32xx_rec_sample prev;
+};
+
+static inline uint32_t paw32xx_rec_zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t paw32xx_rec_unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline uint8_t paw32xx_rec_put_varint(uint8_t *buf, uint32_t v) {
+  uint8_t len = 0;
+
+  while (v >= 0x80) {
+    buf[len++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  buf[len++] = (uint8_t)v;
+
+  return len;
+}
+
+static inline int paw32xx_rec_get_varint(const uint8_t **p, const uint8_t *end,
+                                         uint32_t *v) {
+  uint32_t val = 0;
+
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*p >= end) {
+      return -EINVAL;
+    }
+    val |= (uint32_t)(**p & 0x7f) << shift;
+    if ((*(*p)++ & 0x80) == 0) {
+      *v = val;
+      return 0;
+    }
+  }
+
+  return -EINVAL;
+}
+
+/**
+ * @brief Encode one sample
+ *
+ * @param buf Receives the sample, at least PAW32XX_REC_SAMPLE_MAX bytes
+ * @param prev Previous sample of the block, all zero for the first one
+ * @param s Sample to encode
+ *
+ * @return Number of bytes written
+ */
+static inline uint8_t
+paw32xx_rec_encode(uint8_t *buf, const struct paw32xx_rec_sample *prev,
+                   const struct paw32xx_rec_sample *s) {
+  uint8_t len = 0;
+
+  buf[len++] = s->flags & ~PAW32XX_REC_FLAG_RESERVED;
+  len += paw32xx_rec_put_varint(&buf[len], s->t_us - prev->t_us);
+  len += paw32xx_rec_put_varint(&buf[len],
+                                paw32xx_rec_zigzag((int32_t)s->x - prev->x));
+  len += paw32xx_rec_put_varint(&buf[len],
+                                paw32xx_rec_zigzag((int32_t)s->y - prev->y));
+
+  return len;
+}
+
+/**
+ * @brief Validate a ring header
+ *
+ * @param raw Start of the recording
+ * @param len Length of the recording in bytes
+ * @param hdr Receives the header
+ *
+ * @retval 0 Header is valid and the recording is complete
+ * @retval -EINVAL Not a recording, unknown version or truncated
+ */
+static inline int paw32xx_rec_parse_hdr(const uint8_t *raw, size_t len,
+                                        struct paw32xx_rec_ring_hdr *hdr) {
+  if (len < PAW32XX_REC_RING_HDR_SIZE) {
+    return -EINVAL;
+  }
+  memcpy(hdr, raw, sizeof(*hdr));
+  if (hdr->magic != PAW32XX_REC_MAGIC || hdr->version != PAW32XX_REC_VERSION ||
+      hdr->block_size != PAW32XX_REC_BLOCK_SIZE || hdr->block_count == 0 ||
+      (hdr->block_count & (hdr->block_count - 1)) != 0 ||
+      len < PAW32XX_REC_RING_HDR_SIZE +
+                (size_t)hdr->block_count * PAW32XX_REC_BLOCK_SIZE) {
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Start decoding a block
+ *
+ * @param block Start of the block
+ * @param bhdr Receives the block header
+ * @param cur Cursor to initialize
+ *
+ * @retval 0 Block holds samples
+ * @retval -ENOENT Block is empty
+ * @retval -EINVAL Corrupt block header
+ */
+static inline int paw32xx_rec_block_begin(const uint8_t *block,
+                                          struct paw32xx_rec_block_hdr *bhdr,
+                                          struct paw32xx_rec_cursor *cur) {
+  memcpy(bhdr, block, sizeof(*bhdr));
+  if (bhdr->used == 0) {
+    return -ENOENT;
+  }
+  if (bhdr->used > PAW32XX_REC_PAYLOAD_SIZE) {
+    return -EINVAL;
+  }
+
+  cur->p = block + PAW32XX_REC_BLOCK_HDR_SIZE;
+  cur->end = cur->p + bhdr->used;
+  memset(&cur->prev, 0, sizeof(cur->prev));
+  cur->prev.t_us = bhdr->t0_us;
+
+  return 0;
+}
+
+/**
+ * @brief Decode the next sample of a block
+ *
+ * @param cur Cursor set up by paw32xx_rec_block_begin()
+ * @param s Receives the sample
+ *
+ * @retval 1 Sample decoded
+ * @retval 0 End of block
+ * @retval -EINVAL Corrupt sample
+ */
+static inline int paw32xx_rec_next(struct paw32xx_rec_cursor *cur,
+                                   struct paw32xx_rec_sample *s) {
+  uint32_t dt, dx, dy;
+
+  if (cur->p >= cur->end) {
+    return 0;
+  }
+
+  s->flags = *cur->p++;
+  if ((s->flags & PAW32XX_REC_FLAG_RESERVED) != 0 ||
+      paw32xx_rec_get_varint(&cur->p, cur->end, &dt) < 0 ||
+      paw32xx_rec_get_varint(&cur->p, cur->end, &dx) < 0 ||
+      paw32xx_rec_get_varint(&cur->p, cur->end, &dy) < 0) {
+    return -EINVAL;
+  }
+
+  s->t_us = cur->prev.t_us + dt;
+  s->x = (int16_t)(cur->prev.x + paw32xx_rec_unzigzag(dx));
+  s->y = (int16_t)(cur->prev.y + paw32xx_rec_unzigzag(dy));
+  cur->prev = *s;
+
+  return 1;
+}
+
+#endif /* PAW3222_RECFMT_H_ */
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_RECORDER_H_
+#define PAW3222_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+#ifdef CONFIG_PAW3222_RECORDER
+
+/**
+ * @brief Prepare the recording ring of a device
+ *
+ * Keeps a valid recording left by a previous boot (only possible with
+ * CONFIG_PAW3222_RECORDER_RETAINED) and bumps its boot count, otherwise
+ * formats an empty ring.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_recorder_init(const struct device *dev);
+
+/**
+ * @brief Append a raw sensor sample to the recording
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param status MOTION register value the sample was read with
+ * @param x Raw X delta
+ * @param y Raw Y delta
+ * @param input_mode Input mode the sample is processed in
+ */
+void paw32xx_recorder_sample(const struct device *dev, uint8_t status,
+                             int16_t x, int16_t y, uint8_t input_mode);
+
+/**
+ * @brief Copy part of the raw recording
+ *
+ * The recording is paw32xx_recorder_size() bytes in the format described
+ * in paw3222_recfmt.h.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param offset Byte offset into the recording
+ * @param buf Destination buffer
+ * @param len Number of bytes to copy at most
+ *
+ * @return Number of bytes copied, 0 past the end
+ */
+size_t paw32xx_recorder_read(const struct device *dev, size_t offset,
+                             uint8_t *buf, size_t len);
+
+/**
+ * @brief Get the size of the raw recording in bytes
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+size_t paw32xx_recorder_size(const struct device *dev);
+
+/**
+ * @brief Discard the recording and start a new one
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_recorder_clear(const struct device *dev);
+
+#else
+
+static inline void paw32xx_recorder_init(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_recorder_sample(const struct device *dev,
+                                           uint8_t status, int16_t x,
+                                           int16_t y, uint8_t input_mode) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(status);
+  ARG_UNUSED(x);
+  ARG_UNUSED(y);
+  ARG_UNUSED(input_mode);
+}
+
+#endif /* CONFIG_PAW3222_RECORDER */
+
+#endif /* PAW3222_RECORDER_H_ */
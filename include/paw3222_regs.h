@@ -11,6 +11,8 @@
 
 #include <zephyr/sys/util.h>
 
+#include "paw3222_core.h"
+
 /**
  * @defgroup PAW3222_REGISTERS PAW3222 Register Definitions
  * @brief Register addresses for PAW3222 optical sensor
@@ -68,6 +70,12 @@
 /** @brief Motion detection bit - Set when new motion data is available */
 #define MOTION_STATUS_MOTION BIT(7)
 
+/** @brief Y delta overflow bit - Set when DELTA_Y overflowed since last read */
+#define MOTION_STATUS_DYOVF BIT(4)
+
+/** @brief X delta overflow bit - Set when DELTA_X overflowed since last read */
+#define MOTION_STATUS_DXOVF BIT(3)
+
 /** @} */
 
 /**
@@ -119,7 +127,7 @@
  */
 
 /** @brief Data size in bits for motion delta values */
-#define PAW32XX_DATA_SIZE_BITS 8
+#define PAW32XX_DATA_SIZE_BITS PAW32XX_CORE_DATA_BITS
 /** @brief Required delay in milliseconds after sensor reset */
 #define RESET_DELAY_MS 2
 
@@ -140,21 +148,4 @@
 
 /** @} */
 
-/**
- * @brief PAW3222 input mode enumeration
- * 
- * Defines the different operational modes for interpreting motion data
- * from the PAW3222 sensor. Each mode affects how X/Y motion is processed
- * and what type of input events are generated.
- */
-enum paw32xx_input_mode {
-  PAW32XX_MOVE,                    /**< Standard cursor movement mode */
-  PAW32XX_SCROLL,                  /**< Vertical scroll mode - Y motion generates scroll wheel events */
-  PAW32XX_SCROLL_HORIZONTAL,       /**< Horizontal scroll mode - Y motion generates horizontal scroll events */
-  PAW32XX_SNIPE,                   /**< High-precision cursor movement mode with reduced sensitivity */
-  PAW32XX_SCROLL_SNIPE,            /**< High-precision vertical scroll mode with reduced sensitivity */
-  PAW32XX_SCROLL_HORIZONTAL_SNIPE, /**< High-precision horizontal scroll mode with reduced sensitivity */
-  PAW32XX_BOTHSCROLL,              /**< Simultaneous XY scroll mode (vertical + horizontal) */
-};
-
 #endif /* ZEPHYR_INCLUDE_PAW3222_REGS_H_ */
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_RPC_H_
+#define PAW3222_RPC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/*
+ * Binary tuning and telemetry protocol.
+ *
+ * A request is one opcode byte followed by its arguments; the response
+ * starts with the opcode or'ed with PAW32XX_RPC_RESP and a signed status
+ * byte (0 or a negative errno), followed by the payload if the status is
+ * 0. All multi-byte fields are little-endian. The codec does not depend on
+ * a transport: a host UI subsystem carries the request and response bytes
+ * as an opaque payload, and "paw3222 rpc" carries them as hex over the
+ * shell.
+ */
+
+/** @brief Protocol version reported by PAW32XX_RPC_INFO */
+#define PAW32XX_RPC_VERSION 1
+
+/** @brief Set in the first response byte */
+#define PAW32XX_RPC_RESP 0x80
+
+/** @brief Largest response, a STATS reply with every counter */
+#define PAW32XX_RPC_MAX_RESP 96
+
+/** @brief Request opcodes */
+enum paw32xx_rpc_op {
+  /** -> u8 version, u8 param count, u8 stat count */
+  PAW32XX_RPC_INFO = 0x01,
+  /** u8 id -> u8 id, u8 size, i32 min, i32 max, name (not terminated) */
+  PAW32XX_RPC_PARAM_DESC = 0x02,
+  /** u8 id -> u8 id, i32 value */
+  PAW32XX_RPC_GET = 0x03,
+  /** u8 id, i32 value -> u8 id, i32 value */
+  PAW32XX_RPC_SET = 0x04,
+  /** -> u8 count, u32 counter[count] in enum paw32xx_rpc_stat order */
+  PAW32XX_RPC_STATS = 0x05,
+  /** -> u8 idle, u8 input mode, u8 profile, i16 current cpi, u8 line fault */
+  PAW32XX_RPC_STATE = 0x06,
+  /** -> nothing; clears the counters */
+  PAW32XX_RPC_STATS_RESET = 0x07,
+};
+
+/**
+ * @brief Counters of a STATS reply
+ *
+ * Zero of them without CONFIG_PAW3222_STATS. The ring counters read 0
+ * without CONFIG_PAW3222_PIPELINE, the line counters without
+ * CONFIG_PAW3222_LINE_MONITOR. Append only.
+ */
+enum paw32xx_rpc_stat {
+  PAW32XX_RPC_STAT_IRQS,
+  PAW32XX_RPC_STAT_WORK_RUNS,
+  PAW32XX_RPC_STAT_SAMPLES,
+  PAW32XX_RPC_STAT_REPORTS,
+  PAW32XX_RPC_STAT_SPI_ERRORS,
+  PAW32XX_RPC_STAT_CPI_WRITES,
+  PAW32XX_RPC_STAT_IDLE_ENTRIES,
+  PAW32XX_RPC_STAT_IDLE_EXITS,
+  PAW32XX_RPC_STAT_MODE_CHANGES,
+  PAW32XX_RPC_STAT_WORK_DELAY_MAX_US,
+  PAW32XX_RPC_STAT_REPORT_BLOCK_MAX_US,
+  PAW32XX_RPC_STAT_REPORT_STALLS,
+  PAW32XX_RPC_STAT_RING_OVERRUNS,
+  PAW32XX_RPC_STAT_RING_WAIT_MAX_US,
+  PAW32XX_RPC_STAT_LINE_STUCK,
+  PAW32XX_RPC_STAT_LINE_STORMS,
+  PAW32XX_RPC_STAT_LINE_FALLBACK_RUNS,
+  PAW32XX_RPC_STAT_COUNT,
+};
+
+/**
+ * @brief Handle one request
+ *
+ * Parameter changes go through paw32xx_param_set(), so they never wait
+ * for the motion work. Malformed requests and failed operations still get
+ * a response carrying the error status.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param req Request bytes
+ * @param req_len Number of request bytes
+ * @param resp Buffer for the response
+ * @param resp_size Size of resp; PAW32XX_RPC_MAX_RESP always suffices
+ *
+ * @return Length of the response, or a negative error code
+ * @retval -EINVAL Empty request
+ * @retval -ENOBUFS resp is too small for the response
+ */
+int paw32xx_rpc_handle(const struct device *dev, const uint8_t *req,
+                       size_t req_len, uint8_t *resp, size_t resp_size);
+
+#endif /* PAW3222_RPC_H_ */
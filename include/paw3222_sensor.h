@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_SENSOR_H_
+#define PAW3222_SENSOR_H_
+
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_PAW3222_SENSOR
+#include <zephyr/drivers/sensor.h>
+
+/**
+ * @brief Number of samples batched into one streaming buffer
+ *
+ * A streaming request is completed once this many samples have been
+ * collected or when motion stops, whichever comes first.
+ */
+#define PAW32XX_SENSOR_BATCH_MAX CONFIG_PAW3222_SENSOR_BATCH_SIZE
+
+/**
+ * @brief Single raw motion sample in an encoded buffer
+ */
+struct paw32xx_sensor_sample {
+  uint32_t timestamp_delta; /**< Nanoseconds since the frame base timestamp */
+  int16_t x;                /**< Raw X delta (sign-extended, before rotation) */
+  int16_t y;                /**< Raw Y delta (sign-extended, before rotation) */
+};
+
+/**
+ * @brief Encoded buffer layout produced by the PAW3222 sensor submit path
+ *
+ * The buffer handed to the RTIO consumer starts with this header and is
+ * followed by @ref count samples. It is decoded by the driver's sensor
+ * decoder (see sensor_get_decoder()).
+ */
+struct paw32xx_sensor_encoded {
+  uint64_t base_timestamp_ns;               /**< Timestamp of the first sample */
+  uint16_t count;                           /**< Number of valid samples */
+  uint8_t data_ready : 1;                   /**< Set for streaming (data-ready) frames */
+  uint8_t reserved : 7;
+  struct paw32xx_sensor_sample samples[];   /**< Raw motion samples */
+};
+
+/** @brief Sensor driver API exposed by PAW3222 device instances */
+extern const struct sensor_driver_api paw32xx_sensor_api;
+
+/**
+ * @brief Hand a freshly acquired motion sample to the sensor API
+ *
+ * Records the sample as the unread one-shot reading and appends it to the
+ * pending streaming buffer, if any. The buffer is completed when it is full.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param x Raw X delta as returned by paw32xx_read_xy()
+ * @param y Raw Y delta as returned by paw32xx_read_xy()
+ *
+ * @note Called from the motion work handler. Does not block.
+ */
+void paw32xx_sensor_push(const struct device *dev, int16_t x, int16_t y);
+
+/**
+ * @brief Complete a partially filled streaming buffer
+ *
+ * Called when motion stops so that consumers receive buffered samples
+ * without waiting for the batch to fill up.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_sensor_flush(const struct device *dev);
+
+#else
+
+static inline void paw32xx_sensor_push(const struct device *dev, int16_t x,
+                                       int16_t y) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(x);
+  ARG_UNUSED(y);
+}
+
+static inline void paw32xx_sensor_flush(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+#endif /* CONFIG_PAW3222_SENSOR */
+
+#endif /* PAW3222_SENSOR_H_ */
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_SNAPSHOT_H_
+#define PAW3222_SNAPSHOT_H_
+
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+#ifdef CONFIG_PAW3222_SNAPSHOT
+
+/**
+ * @brief Pick up the previous boot's snapshot and start saving
+ *
+ * Copies the newest valid snapshot left in retained RAM by the previous
+ * boot, logs a summary of it and schedules the first save of this boot.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_snapshot_init(const struct device *dev);
+
+/**
+ * @brief Save the snapshot as soon as possible
+ *
+ * The save runs on the system work queue; periodic saves continue while
+ * the driver is not idle.
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_snapshot_request(const struct device *dev);
+
+/**
+ * @brief Get the last snapshot saved by the previous boot
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param snap Receives the snapshot
+ *
+ * @retval 0 Snapshot copied
+ * @retval -ENODATA No valid snapshot was retained (cold boot, different
+ *         build or RAM not retained across the reset)
+ */
+int paw32xx_snapshot_prev(const struct device *dev,
+                          struct paw32xx_snapshot *snap);
+
+#else
+
+static inline void paw32xx_snapshot_init(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+static inline void paw32xx_snapshot_request(const struct device *dev) {
+  ARG_UNUSED(dev);
+}
+
+#endif /* CONFIG_PAW3222_SNAPSHOT */
+
+#endif /* PAW3222_SNAPSHOT_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_TRACE_H_
+#define PAW3222_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+
+/**
+ * @brief Trace record types
+ */
+enum paw32xx_trace_type {
+  PAW32XX_TRACE_SAMPLE, /**< Motion sample: a = x, b = y, arg = input mode */
+  PAW32XX_TRACE_MODE,   /**< Effective mode change: arg = mode, a = profile */
+  PAW32XX_TRACE_CPI,    /**< CPI register write: a = CPI */
+  PAW32XX_TRACE_IDLE,   /**< Idle transition: arg = 1 on entry, 0 on exit */
+};
+
+#ifdef CONFIG_PAW3222_TRACE
+
+/**
+ * @brief Append a record to the trace ring
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param type Record type (enum paw32xx_trace_type)
+ * @param arg Type specific small argument
+ * @param a Type specific value
+ * @param b Type specific value
+ *
+ * @note Does not block and may be called from any thread context.
+ */
+void paw32xx_trace_record(const struct device *dev, uint8_t type, uint8_t arg,
+                          int16_t a, int16_t b);
+
+/**
+ * @brief Get the range of sequence numbers held in the ring
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param first Receives the sequence number of the oldest record
+ * @param next Receives the sequence number the next record will get
+ */
+void paw32xx_trace_range(const struct device *dev, uint32_t *first,
+                         uint32_t *next);
+
+/**
+ * @brief Copy one record out of the trace ring
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ * @param seq Sequence number of the record
+ * @param rec Receives the record
+ *
+ * @retval 0 Record copied
+ * @retval -ENOENT Record not written yet or already overwritten
+ */
+int paw32xx_trace_get(const struct device *dev, uint32_t seq,
+                      struct paw32xx_trace_rec *rec);
+
+/**
+ * @brief Discard all trace records of a device
+ *
+ * @param dev PAW3222 device pointer (must not be NULL)
+ */
+void paw32xx_trace_clear(const struct device *dev);
+
+static inline void paw32xx_trace_sample(const struct device *dev, int16_t x,
+                                        int16_t y, uint8_t input_mode) {
+  paw32xx_trace_record(dev, PAW32XX_TRACE_SAMPLE, input_mode, x, y);
+}
+
+static inline void paw32xx_trace_mode(const struct device *dev, uint8_t mode,
+                                      uint8_t profile) {
+  paw32xx_trace_record(dev, PAW32XX_TRACE_MODE, mode, profile, 0);
+}
+
+static inline void paw32xx_trace_cpi(const struct device *dev, int16_t cpi) {
+  paw32xx_trace_record(dev, PAW32XX_TRACE_CPI, 0, cpi, 0);
+}
+
+static inline void paw32xx_trace_idle(const struct device *dev, bool enter) {
+  paw32xx_trace_record(dev, PAW32XX_TRACE_IDLE, enter ? 1 : 0, 0, 0);
+}
+
+#else
+
+static inline void paw32xx_trace_sample(const struct device *dev, int16_t x,
+                                        int16_t y, uint8_t input_mode) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(x);
+  ARG_UNUSED(y);
+  ARG_UNUSED(input_mode);
+}
+
+static inline void paw32xx_trace_mode(const struct device *dev, uint8_t mode,
+                                      uint8_t profile) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(mode);
+  ARG_UNUSED(profile);
+}
+
+static inline void paw32xx_trace_cpi(const struct device *dev, int16_t cpi) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(cpi);
+}
+
+static inline void paw32xx_trace_idle(const struct device *dev, bool enter) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(enter);
+}
+
+#endif /* CONFIG_PAW3222_TRACE */
+
+#endif /* PAW3222_TRACE_H_ */
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_TRACING_H_
+#define PAW3222_TRACING_H_
+
+/**
+ * @brief Zephyr tracing hooks for the motion pipeline stages
+ *
+ * Each stage emits a pair of named events, "paw_<stage>_enter" and
+ * "paw_<stage>_exit", through sys_trace_named_event() so that CTF or
+ * SystemView captures show the driver stages on the same timeline as the
+ * kernel's thread and ISR events. Names are kept below the 20 character
+ * limit of the CTF named event record.
+ *
+ * Stages: irq, timer, spi, mode, cpi, xform, report.
+ */
+
+#ifdef CONFIG_PAW3222_TRACING
+
+#include <stdint.h>
+#include <zephyr/tracing/tracing.h>
+
+/** @brief Mark the start of a pipeline stage */
+#define PAW32XX_TRACING_ENTER(stage, arg)                                      \
+  sys_trace_named_event("paw_" #stage "_enter", (uint32_t)(arg), 0)
+
+/** @brief Mark the end of a pipeline stage */
+#define PAW32XX_TRACING_EXIT(stage, arg)                                       \
+  sys_trace_named_event("paw_" #stage "_exit", (uint32_t)(arg), 0)
+
+#else
+
+/* The argument is still referenced so values only traced stay used */
+#define PAW32XX_TRACING_ENTER(stage, arg)                                      \
+  do {                                                                         \
+    (void)(arg);                                                               \
+  } while (0)
+#define PAW32XX_TRACING_EXIT(stage, arg)                                       \
+  do {                                                                         \
+    (void)(arg);                                                               \
+  } while (0)
+
+#endif /* CONFIG_PAW3222_TRACING */
+
+#endif /* PAW3222_TRACING_H_ */
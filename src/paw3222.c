@@ -12,6 +12,7 @@
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/spi.h>
+#include <zephyr/input/input.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/pm/device.h>
@@ -20,7 +21,13 @@
 
 #include "paw3222.h"
 #include "paw3222_input.h"
+#include "paw3222_latency.h"
+#include "paw3222_line.h"
+#include "paw3222_pipeline.h"
 #include "paw3222_power.h"
+#include "paw3222_recorder.h"
+#include "paw3222_sensor.h"
+#include "paw3222_snapshot.h"
 
 LOG_MODULE_REGISTER(paw32xx, CONFIG_ZMK_LOG_LEVEL);
 
@@ -28,6 +35,76 @@ LOG_MODULE_REGISTER(paw32xx, CONFIG_ZMK_LOG_LEVEL);
 
 #if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
 
+#ifdef CONFIG_PAW3222_SENSOR
+#define PAW32XX_DEVICE_API (&paw32xx_sensor_api)
+#else
+#define PAW32XX_DEVICE_API NULL
+#endif
+
+#ifdef PAW32XX_LATENCY_INPUT_HOP
+/* Sees a synced report when the input subsystem hands it to the listeners */
+#define PAW32XX_LATENCY_INPUT_CB(n)                                            \
+  static void paw32xx_latency_input_##n(struct input_event *evt) {             \
+    if (evt->sync) {                                                           \
+      paw32xx_latency_mark_hid(evt->dev);                                      \
+    }                                                                          \
+  }                                                                            \
+  INPUT_CALLBACK_DEFINE(DEVICE_DT_INST_GET(n), paw32xx_latency_input_##n);
+#else
+#define PAW32XX_LATENCY_INPUT_CB(n)
+#endif
+
+/* A retained recording must not be cleared by the C runtime on warm boot */
+#ifdef CONFIG_PAW3222_RECORDER_RETAINED
+#define PAW32XX_REC_RING_ATTR __noinit
+#else
+#define PAW32XX_REC_RING_ATTR
+#endif
+
+/**
+ * @brief Adopt the sensor as a previous boot left it
+ *
+ * Only tried when the warm boot marker survived the reset. With a power
+ * pin the sensor is switched on without the power cycle first; if it did
+ * lose power or its configuration, paw32xx_configure_warm() notices and
+ * the caller runs the full sequence.
+ *
+ * @param dev PAW3222 device instance
+ *
+ * @retval true The sensor is configured; skip the power cycle and reset
+ */
+static bool paw32xx_warm_boot(const struct device *dev)
+{
+  int ret;
+
+  if (!paw32xx_warm_valid(dev))
+  {
+    return false;
+  }
+
+#if DT_INST_NODE_HAS_PROP(0, power_gpios)
+  const struct paw32xx_config *cfg = dev->config;
+
+  if (gpio_is_ready_dt(&cfg->power_gpio))
+  {
+    ret = gpio_pin_configure_dt(&cfg->power_gpio, GPIO_OUTPUT_ACTIVE);
+    if (ret != 0)
+    {
+      return false;
+    }
+  }
+#endif
+
+  ret = paw32xx_configure_warm(dev);
+  if (ret != 0)
+  {
+    LOG_INF("Sensor not left configured (%d), full init", ret);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * @brief Initialize the PAW3222 device
  *
@@ -54,12 +131,18 @@ static int paw32xx_init(const struct device *dev)
 {
   const struct paw32xx_config *cfg = dev->config;
   struct paw32xx_data *data = dev->data;
+  uint32_t start = k_uptime_get_32();
   int ret;
 
   data->current_cpi = -1;                 // Initialize to invalid value to ensure CPI is set on first use
-  data->scroll_accumulator = 0;           // Initialize scroll accumulator
+  paw32xx_core_reset(&data->core);        // Initialize scroll accumulators
   data->current_mode = PAW32XX_MODE_MOVE; // Initialize to move mode
   data->mode_toggle_state = false;
+  data->mode_stack_len = 0;
+  data->input_mode = PAW32XX_MOVE;
+  data->profile = 0;
+  paw32xx_tuning_init(dev);
+  paw32xx_recorder_init(dev);
 
   if (!spi_is_ready_dt(&cfg->spi))
   {
@@ -74,6 +157,7 @@ static int paw32xx_init(const struct device *dev)
   paw32xx_set_device_reference(dev);
 #endif
 
+  paw32xx_pipeline_init(dev);
   k_work_init(&data->motion_work, paw32xx_motion_work_handler);
   k_timer_init(&data->motion_timer, paw32xx_motion_timer_handler, NULL);
   /* Initialize per-device idle timer (handler declared in paw3222_input.h)
@@ -81,10 +165,16 @@ static int paw32xx_init(const struct device *dev)
    * when exiting idle. This guarantees the timer structure is ready.
    */
   k_timer_init(&data->idle_timer, paw32xx_idle_timeout_handler, NULL);
-  data->idle_timer_inited = true;
+  k_work_init(&data->idle_work, paw32xx_idle_work_handler);
+  k_work_init(&data->tune_work, paw32xx_tuning_work_handler);
+  paw32xx_idle_init(&data->idle_sm, CONFIG_PAW3222_REDUCED_SCAN);
+  paw32xx_line_init(dev);
+  paw32xx_snapshot_init(dev);
+
+  data->warm_boot = paw32xx_warm_boot(dev);
 
 #if DT_INST_NODE_HAS_PROP(0, power_gpios)
-  if (gpio_is_ready_dt(&cfg->power_gpio))
+  if (!data->warm_boot && gpio_is_ready_dt(&cfg->power_gpio))
   {
     ret = gpio_pin_configure_dt(&cfg->power_gpio, GPIO_OUTPUT_INACTIVE);
     if (ret != 0)
@@ -126,7 +216,7 @@ static int paw32xx_init(const struct device *dev)
     return ret;
   }
 
-  ret = paw32xx_configure(dev);
+  ret = data->warm_boot ? 0 : paw32xx_configure(dev);
   if (ret != 0)
   {
     LOG_ERR("Device configuration failed: %d", ret);
@@ -143,6 +233,9 @@ static int paw32xx_init(const struct device *dev)
     return ret;
   }
 
+  /* Pick up a layer-selected mode that is already active at boot */
+  paw32xx_update_effective_mode(dev);
+
   ret = pm_device_runtime_enable(dev);
   if (ret < 0)
   {
@@ -152,6 +245,9 @@ static int paw32xx_init(const struct device *dev)
     return ret;
   }
 
+  data->init_ms = k_uptime_get_32() - start;
+  LOG_INF("Initialized in %u ms (%s boot)", data->init_ms,
+          data->warm_boot ? "warm" : "cold");
   return 0;
 }
 
@@ -159,6 +255,12 @@ static int paw32xx_init(const struct device *dev)
   (SPI_OP_MODE_MASTER | SPI_WORD_SET(8) | SPI_MODE_CPOL | SPI_MODE_CPHA | \
    SPI_TRANSFER_MSB)
 
+/* Profile CPIs are written as they are: reject what the sensor cannot take */
+#define PAW32XX_CPI_PROFILE_CHECK(node_id, prop, idx)                                       \
+  BUILD_ASSERT(DT_PROP_BY_IDX(node_id, prop, idx) >= RES_MIN &&                             \
+                   DT_PROP_BY_IDX(node_id, prop, idx) <= RES_MAX,                           \
+               "cpi-profiles entries must be within 608..4826");
+
 #define PAW32XX_INIT(n)                                                                     \
   COND_CODE_1(                                                                              \
       DT_INST_NODE_HAS_PROP(n, scroll_layers),                                              \
@@ -184,6 +286,16 @@ static int paw32xx_init(const struct device *dev)
               (static int32_t bothscroll_layers##n[] =                                      \
                    DT_INST_PROP(n, bothscroll_layers);),                                    \
               (/* Do nothing */))                                                           \
+  COND_CODE_1(DT_INST_NODE_HAS_PROP(n, cpi_profiles),                                       \
+              (static int32_t cpi_profiles##n[] = DT_INST_PROP(n, cpi_profiles);            \
+               DT_INST_FOREACH_PROP_ELEM(n, cpi_profiles, PAW32XX_CPI_PROFILE_CHECK)),      \
+              (/* Do nothing */))                                                           \
+  IF_ENABLED(CONFIG_PAW3222_RECORDER,                                                       \
+             (static struct paw32xx_rec_ring paw32xx_rec_ring_##n PAW32XX_REC_RING_ATTR;))  \
+  IF_ENABLED(CONFIG_PAW3222_SNAPSHOT,                                                       \
+             (static struct paw32xx_snapshot_area paw32xx_snapshot_##n __noinit;))          \
+  IF_ENABLED(CONFIG_PAW3222_WARM_BOOT,                                                      \
+             (static struct paw32xx_warm paw32xx_warm_##n __noinit;))                       \
   static const struct paw32xx_config paw32xx_cfg_##n = {                                    \
       .spi = SPI_DT_SPEC_INST_GET(n, PAW32XX_SPI_MODE, 0),                                  \
       .irq_gpio = GPIO_DT_SPEC_INST_GET(n, irq_gpios),                                      \
@@ -198,6 +310,11 @@ static int paw32xx_init(const struct device *dev)
       .bothscroll_layers_len =                                                              \
           COND_CODE_1(DT_INST_NODE_HAS_PROP(n, bothscroll_layers),                          \
                       (DT_INST_PROP_LEN(n, bothscroll_layers)), (0)),                       \
+      .cpi_profiles = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, cpi_profiles),                   \
+                                  (cpi_profiles##n), (NULL)),                               \
+      .cpi_profiles_len =                                                                   \
+          COND_CODE_1(DT_INST_NODE_HAS_PROP(n, cpi_profiles),                               \
+                      (DT_INST_PROP_LEN(n, cpi_profiles)), (0)),                            \
       .snipe_layers = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, snipe_layers),                   \
                                   (snipe_layers##n), (NULL)),                               \
       .snipe_layers_len =                                                                   \
@@ -234,12 +351,16 @@ static int paw32xx_init(const struct device *dev)
           DT_INST_PROP_OR(n, rotation, CONFIG_PAW3222_SENSOR_ROTATION),                     \
       .scroll_tick =                                                                        \
           DT_INST_PROP_OR(n, scroll_tick, CONFIG_PAW3222_SCROLL_TICK),                      \
+      IF_ENABLED(CONFIG_PAW3222_RECORDER, (.rec_ring = &paw32xx_rec_ring_##n,))             \
+      IF_ENABLED(CONFIG_PAW3222_SNAPSHOT, (.snapshot = &paw32xx_snapshot_##n,))             \
+      IF_ENABLED(CONFIG_PAW3222_WARM_BOOT, (.warm = &paw32xx_warm_##n,))                    \
       .switch_method = DT_ENUM_IDX_OR(DT_DRV_INST(n), switch_method, PAW32XX_SWITCH_LAYER)};\
   static struct paw32xx_data paw32xx_data_##n;                                              \
   PM_DEVICE_DT_INST_DEFINE(n, paw32xx_pm_action);                                           \
   DEVICE_DT_INST_DEFINE(n, paw32xx_init, PM_DEVICE_DT_INST_GET(n),                          \
                         &paw32xx_data_##n, &paw32xx_cfg_##n, POST_KERNEL,                   \
-                        CONFIG_INPUT_INIT_PRIORITY, NULL);
+                        CONFIG_INPUT_INIT_PRIORITY, PAW32XX_DEVICE_API);                    \
+  PAW32XX_LATENCY_INPUT_CB(n)
 
 DT_INST_FOREACH_STATUS_OKAY(PAW32XX_INIT)
 
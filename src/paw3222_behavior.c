@@ -12,6 +12,8 @@
 #include <drivers/behavior.h>
 #endif
 
+#include <dt-bindings/zmk/paw32xx.h>
+
 #include "paw3222.h"
 #include "paw3222_input.h"
 
@@ -53,18 +55,17 @@ void paw32xx_set_device_reference(const struct device *dev)
 /**
  * @brief Change the PAW3222 input mode and log the change
  *
- * Updates the current input mode of the PAW3222 sensor and logs the change
- * for debugging purposes. This is a helper function used by the various
- * toggle mode functions.
+ * Updates the effective input mode of the PAW3222 sensor, publishes it as a
+ * zmk_paw32xx_mode_changed event and pre-applies it (scroll accumulators
+ * cleared, CPI queued). This is a helper function used by the toggle and
+ * direct-selection functions.
  *
  * @param new_mode The new input mode to set
  * 
  * @return 0 on success, negative error code on failure
  * @retval 0 Mode changed successfully
  * @retval -ENODEV PAW3222 device not initialized or not available
- * 
- * @note This function updates the mode immediately and the change takes
- *       effect on the next motion event.
+ * @retval -EINVAL Unknown mode
  */
 static int paw32xx_change_mode(enum paw32xx_current_mode new_mode)
 {
@@ -73,151 +74,191 @@ static int paw32xx_change_mode(enum paw32xx_current_mode new_mode)
         return -ENODEV;
     }
 
-    struct paw32xx_data *data = paw3222_dev->data;
-    data->current_mode = new_mode;
+    if ((unsigned int)new_mode >= PAW32XX_MODE_COUNT) {
+        LOG_ERR("Unknown PAW3222 mode: %d", new_mode);
+        return -EINVAL;
+    }
 
-    const char* mode_names[] = {
-        "MOVE", "SCROLL", "SCROLL_HORIZONTAL",
-        "SNIPE", "SCROLL_SNIPE", "SCROLL_HORIZONTAL_SNIPE"
-    };
+    paw32xx_mode_set_effective(paw3222_dev, new_mode);
+    paw32xx_update_effective_mode(paw3222_dev);
+    paw32xx_apply_mode(paw3222_dev);
 
-    if ((int)new_mode >= 0 && new_mode < ARRAY_SIZE(mode_names)) {
-        LOG_INF("Switched to %s mode", mode_names[new_mode]);
-    }
+    LOG_INF("Switched to %s mode", paw32xx_mode_name(new_mode));
 
     return 0;
 }
 
+/** @brief Marks a mode without a transition in paw32xx_toggle_table */
+#define PAW32XX_TOGGLE_NONE 0xff
+
 /**
- * @brief Toggle between cursor movement and scroll modes
+ * @brief Toggle transition table
  *
- * Switches between cursor movement modes (MOVE/SNIPE) and scroll modes
- * (SCROLL/SCROLL_SNIPE/SCROLL_HORIZONTAL/SCROLL_HORIZONTAL_SNIPE).
- * 
- * Mode transitions:
- * - From MOVE or SNIPE: Switch to SCROLL
- * - From any SCROLL mode: Switch to MOVE
+ * Indexed by toggle function (behavior parameter 0-2) and the effective
+ * mode; yields the mode to switch to.
+ *
+ * - Move/Scroll (0): cursor modes -> SCROLL, any scroll mode -> MOVE
+ * - Normal/Snipe (1): toggles the snipe variant of the current mode
+ * - Vertical/Horizontal (2): swaps scroll direction, keeping precision;
+ *   not available in cursor or XY scroll modes
+ */
+static const uint8_t paw32xx_toggle_table[][PAW32XX_MODE_COUNT] = {
+    [PAW_TOG_MOVE_SCROLL] = {
+        [PAW32XX_MODE_MOVE] = PAW32XX_MODE_SCROLL,
+        [PAW32XX_MODE_SCROLL] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_SNIPE] = PAW32XX_MODE_SCROLL,
+        [PAW32XX_MODE_SCROLL_SNIPE] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_BOTHSCROLL] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_BOTHSCROLL_SNIPE] = PAW32XX_MODE_MOVE,
+    },
+    [PAW_TOG_NORMAL_SNIPE] = {
+        [PAW32XX_MODE_MOVE] = PAW32XX_MODE_SNIPE,
+        [PAW32XX_MODE_SCROLL] = PAW32XX_MODE_SCROLL_SNIPE,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL] = PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE,
+        [PAW32XX_MODE_SNIPE] = PAW32XX_MODE_MOVE,
+        [PAW32XX_MODE_SCROLL_SNIPE] = PAW32XX_MODE_SCROLL,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE] = PAW32XX_MODE_SCROLL_HORIZONTAL,
+        [PAW32XX_MODE_BOTHSCROLL] = PAW32XX_MODE_BOTHSCROLL_SNIPE,
+        [PAW32XX_MODE_BOTHSCROLL_SNIPE] = PAW32XX_MODE_BOTHSCROLL,
+    },
+    [PAW_TOG_VERT_HORIZ] = {
+        [PAW32XX_MODE_MOVE] = PAW32XX_TOGGLE_NONE,
+        [PAW32XX_MODE_SCROLL] = PAW32XX_MODE_SCROLL_HORIZONTAL,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL] = PAW32XX_MODE_SCROLL,
+        [PAW32XX_MODE_SNIPE] = PAW32XX_TOGGLE_NONE,
+        [PAW32XX_MODE_SCROLL_SNIPE] = PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE,
+        [PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE] = PAW32XX_MODE_SCROLL_SNIPE,
+        [PAW32XX_MODE_BOTHSCROLL] = PAW32XX_TOGGLE_NONE,
+        [PAW32XX_MODE_BOTHSCROLL_SNIPE] = PAW32XX_TOGGLE_NONE,
+    },
+};
+
+/**
+ * @brief Apply one of the toggle functions to the effective mode
+ *
+ * @param toggle Toggle function (PAW_TOG_* from dt-bindings/zmk/paw32xx.h)
  *
  * @return 0 on success, negative error code on failure
  * @retval 0 Mode toggled successfully
- * @retval -ENODEV PAW3222 device not initialized
- * 
- * @note This implements parameter 0 of the paw_mode behavior
+ * @retval -ENODEV PAW3222 device not initialized, or the toggle has no
+ *                 transition from the current mode
  */
-static int paw32xx_move_scroll_toggle_mode(void)
+static int paw32xx_toggle_mode(uint32_t toggle)
 {
     if (!paw3222_dev) {
         LOG_ERR("PAW3222 device not initialized");
         return -ENODEV;
     }
 
-    struct paw32xx_data *data = paw3222_dev->data;
-
-    switch (data->current_mode) {
-        case PAW32XX_MODE_MOVE:
-        case PAW32XX_MODE_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL);
-        case PAW32XX_MODE_SCROLL:
-        case PAW32XX_MODE_SCROLL_HORIZONTAL:
-        case PAW32XX_MODE_SCROLL_SNIPE:
-        case PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_MOVE);
-        default:
-            LOG_ERR("Unsupported mode");
-            return -ENODEV;
+    enum paw32xx_current_mode mode = paw32xx_mode_effective(paw3222_dev);
+    uint8_t next = paw32xx_toggle_table[toggle][mode];
+
+    if (next == PAW32XX_TOGGLE_NONE) {
+        LOG_INF("PAW3222 toggle %d not available in %s mode", toggle, paw32xx_mode_name(mode));
+        return -ENODEV;
     }
+
+    return paw32xx_change_mode(next);
 }
 
 /**
- * @brief Toggle between normal and high-precision (snipe) modes
+ * @brief Select the active profile
  *
- * Toggles the high-precision (snipe) mode for the current operation type.
- * This affects sensitivity but maintains the same operation (move vs scroll).
- * 
- * Mode transitions:
- * - MOVE ↔ SNIPE (cursor movement)
- * - SCROLL ↔ SCROLL_SNIPE (vertical scrolling)
- * - SCROLL_HORIZONTAL ↔ SCROLL_HORIZONTAL_SNIPE (horizontal scrolling)
+ * @param profile Profile index (0 = res-cpi, n = cpi-profiles[n - 1])
  *
  * @return 0 on success, negative error code on failure
- * @retval 0 Mode toggled successfully
- * @retval -ENODEV PAW3222 device not initialized or unsupported mode
- * 
- * @note This implements parameter 1 of the paw_mode behavior
+ * @retval -ENODEV PAW3222 device not initialized
+ * @retval -EINVAL Profile index not configured
  */
-static int paw32xx_normal_snipe_toggle_mode(void)
+static int paw32xx_change_profile(uint8_t profile)
 {
     if (!paw3222_dev) {
         LOG_ERR("PAW3222 device not initialized");
         return -ENODEV;
     }
 
-    struct paw32xx_data *data = paw3222_dev->data;
-
-    switch (data->current_mode) {
-        case PAW32XX_MODE_MOVE:
-            return paw32xx_change_mode(PAW32XX_MODE_SNIPE);
-        case PAW32XX_MODE_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_MOVE);
-        case PAW32XX_MODE_SCROLL:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_SNIPE);
-        case PAW32XX_MODE_SCROLL_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL);
-        case PAW32XX_MODE_SCROLL_HORIZONTAL:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE);
-        case PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_HORIZONTAL);
-        default:
-            LOG_ERR("Unsupported mode");
-            return -ENODEV;
+    int ret = paw32xx_set_profile(paw3222_dev, profile);
+    if (ret == 0) {
+        LOG_INF("Switched to profile %d", profile);
     }
+    return ret;
 }
 
 /**
- * @brief Toggle between vertical and horizontal scroll directions
+ * @brief Check whether a behavior parameter selects a momentary (hold) mode
  *
- * Switches scroll direction between vertical and horizontal while maintaining
- * the same precision level (normal vs snipe). Only works when already in a
- * scroll mode - has no effect in cursor movement modes.
- * 
- * Mode transitions:
- * - SCROLL ↔ SCROLL_HORIZONTAL
- * - SCROLL_SNIPE ↔ SCROLL_HORIZONTAL_SNIPE
- * - MOVE/SNIPE: No effect (logs info message)
+ * @param param Behavior parameter (see dt-bindings/zmk/paw32xx.h)
+ *
+ * @return true for PAW_HOLD(mode) parameters
+ */
+static inline bool paw32xx_param_is_hold(uint32_t param)
+{
+    return (param & ~0xffU) == PAW_HOLD_BASE;
+}
+
+/**
+ * @brief Switch to a mode for as long as the binding is held
+ *
+ * Pushes the target mode onto the device's mode stack and pre-applies it so
+ * the first motion sample is already processed with the new sensitivity.
+ * Holds nest: the most recently pressed binding is effective, and each
+ * binding removes only its own entry on release.
+ *
+ * @param target Mode to activate while the key is held
+ * @param position Key position of the binding
  *
  * @return 0 on success, negative error code on failure
- * @retval 0 Mode toggled successfully
- * @retval -ENODEV PAW3222 device not initialized, not in scroll mode, or unsupported mode
- * 
- * @note This implements parameter 2 of the paw_mode behavior
+ * @retval -ENODEV PAW3222 device not initialized
+ * @retval -EINVAL Target is not a valid mode
+ * @retval -ENOMEM Mode stack is full
  */
-static int paw32xx_vertical_horizontal_toggle_mode(void)
+static int paw32xx_hold_mode_pressed(enum paw32xx_current_mode target, uint32_t position)
 {
     if (!paw3222_dev) {
         LOG_ERR("PAW3222 device not initialized");
         return -ENODEV;
     }
 
-    struct paw32xx_data *data = paw3222_dev->data;
+    if ((unsigned int)target >= PAW32XX_MODE_COUNT) {
+        LOG_ERR("Unknown PAW3222 hold mode: %d", target);
+        return -EINVAL;
+    }
+
+    int ret = paw32xx_mode_push(paw3222_dev, target, position);
+    if (ret < 0) {
+        return ret;
+    }
+
+    paw32xx_update_effective_mode(paw3222_dev);
+    paw32xx_apply_mode(paw3222_dev);
+    return 0;
+}
 
-    if (data->current_mode == PAW32XX_MODE_MOVE || data->current_mode == PAW32XX_MODE_SNIPE) {
-        LOG_INF("PAW3222 not SCROLL MODE");
+/**
+ * @brief Remove the momentary mode pushed by a hold binding
+ *
+ * @param position Key position of the released binding
+ *
+ * @return 0 on success, negative error code on failure
+ * @retval -ENODEV PAW3222 device not initialized
+ */
+static int paw32xx_hold_mode_released(uint32_t position)
+{
+    if (!paw3222_dev) {
+        LOG_ERR("PAW3222 device not initialized");
         return -ENODEV;
     }
 
-    switch (data->current_mode) {
-        case PAW32XX_MODE_SCROLL:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_HORIZONTAL);
-        case PAW32XX_MODE_SCROLL_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE);
-        case PAW32XX_MODE_SCROLL_HORIZONTAL:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL);
-        case PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE:
-            return paw32xx_change_mode(PAW32XX_MODE_SCROLL_SNIPE);
-        default:
-            LOG_ERR("Unsupported mode");
-            return -ENODEV;
+    if (paw32xx_mode_pop(paw3222_dev, position) < 0) {
+        /* Press was rejected (e.g. stack full); nothing to restore */
+        return 0;
     }
+
+    paw32xx_update_effective_mode(paw3222_dev);
+    paw32xx_apply_mode(paw3222_dev);
+    return 0;
 }
 
 /**
@@ -230,6 +271,9 @@ static int paw32xx_vertical_horizontal_toggle_mode(void)
  * - 0: Move/Scroll toggle
  * - 1: Normal/Snipe toggle  
  * - 2: Vertical/Horizontal toggle
+ * - PAW_HOLD(mode): Switch to mode while held (pushed on the mode stack)
+ * - PAW_SET(mode): Switch directly to mode
+ * - PAW_PROFILE(n): Switch directly to profile n
  *
  * @param binding Pointer to the behavior binding containing parameters
  * @param binding_event Event information (unused)
@@ -247,16 +291,28 @@ static int on_paw32xx_mode_binding_pressed(
 
     LOG_DBG("PAW32xx mode binding pressed: param1=%d", param1);
 
+    if (paw32xx_param_is_hold(param1)) {
+        LOG_DBG("Hold mode %d", param1 & 0xff);
+        return paw32xx_hold_mode_pressed(param1 & 0xff, binding_event.position);
+    }
+
+    switch (param1 & ~0xffU) {
+        case PAW_SET_BASE: // Direct mode selection
+            LOG_DBG("Set mode %d", param1 & 0xff);
+            return paw32xx_change_mode(param1 & 0xff);
+        case PAW_PROFILE_BASE: // Direct profile selection
+            LOG_DBG("Set profile %d", param1 & 0xff);
+            return paw32xx_change_profile(param1 & 0xff);
+        default:
+            break;
+    }
+
     switch (param1) {
-        case 0: // Move <-> Scroll Toggle mode
-            LOG_DBG("Move <-> Scroll Toggle mode");
-            return paw32xx_move_scroll_toggle_mode();
-        case 1: // Normal <-> Snipe Toggle mode
-            LOG_DBG("Normal <-> Snipe Toggle mode");
-            return paw32xx_normal_snipe_toggle_mode();
-        case 2: // Vertical <-> Horizontal mode
-            LOG_DBG("Vertical <-> Horizontal mode");
-            return paw32xx_vertical_horizontal_toggle_mode();
+        case PAW_TOG_MOVE_SCROLL: // Move <-> Scroll Toggle mode
+        case PAW_TOG_NORMAL_SNIPE: // Normal <-> Snipe Toggle mode
+        case PAW_TOG_VERT_HORIZ: // Vertical <-> Horizontal mode
+            LOG_DBG("Toggle function %d", param1);
+            return paw32xx_toggle_mode(param1);
         default:
             LOG_ERR("Unknown PAW3222 mode parameter: %d", param1);
             return -EINVAL;
@@ -266,14 +322,14 @@ static int on_paw32xx_mode_binding_pressed(
 /**
  * @brief Handle PAW3222 mode behavior key release events
  *
- * Called when a paw_mode behavior key is released. For toggle-based behaviors,
- * no action is typically needed on key release, so this function serves as
- * a placeholder for the behavior API.
+ * Called when a paw_mode behavior key is released. Toggle, set and profile
+ * functions need no action on release; momentary (hold) functions remove their entry from the
+ * mode stack, which restores whichever mode is below it.
  *
  * @param binding Pointer to the behavior binding containing parameters
  * @param binding_event Event information (unused)
  * 
- * @return Always returns 0 (no action needed for toggle behaviors)
+ * @return 0 on success, negative error code on failure
  */
 static int on_paw32xx_mode_binding_released(
     struct zmk_behavior_binding *binding,
@@ -283,14 +339,12 @@ static int on_paw32xx_mode_binding_released(
 
     LOG_DBG("PAW32xx mode binding released: param1=%d", param1);
 
-    switch (param1) {
-        case 0: // Toggle modes - no action on release
-        case 1:
-        case 2:
-            return 0;
-        default:
-            return 0;
+    if (paw32xx_param_is_hold(param1)) {
+        return paw32xx_hold_mode_released(binding_event.position);
     }
+
+    // Toggle, set and profile functions - no action on release
+    return 0;
 }
 
 #if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
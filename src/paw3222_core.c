@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* No Zephyr includes: this file is also built for the host tools */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "paw3222_core.h"
+
+static inline int16_t abs_int16(int16_t value) {
+  return (value < 0) ? -value : value;
+}
+
+/* Returns true when the accumulator had to be clamped */
+static inline bool add_to_scroll_accumulator(int16_t *accumulator,
+                                             int16_t delta) {
+  int32_t temp = (int32_t)*accumulator + delta;
+
+  if (temp > INT16_MAX) {
+    *accumulator = INT16_MAX;
+    return true;
+  }
+  if (temp < INT16_MIN) {
+    *accumulator = INT16_MIN;
+    return true;
+  }
+
+  *accumulator = (int16_t)temp;
+  return false;
+}
+
+/* Unsynced; paw32xx_core_process() syncs the last event of the sample */
+static void paw32xx_core_emit(struct paw32xx_core_out *out, uint8_t code,
+                              int16_t value) {
+  struct paw32xx_core_event *ev = &out->ev[out->count++];
+
+  ev->code = code;
+  ev->value = value;
+  ev->sync = false;
+}
+
+/* Emits at most one scroll step per sample, leaving the rest accumulated */
+static void paw32xx_core_scroll(struct paw32xx_core_out *out,
+                                int16_t *accumulator, int16_t scroll_delta,
+                                uint8_t threshold, bool is_horizontal) {
+  if (add_to_scroll_accumulator(accumulator, scroll_delta)) {
+    out->clamped = true;
+  }
+
+  if (abs_int16(*accumulator) >= threshold) {
+    int16_t scroll_direction = (*accumulator > 0) ? 1 : -1;
+
+    paw32xx_core_emit(out,
+                      is_horizontal ? PAW32XX_CORE_REL_HWHEEL
+                                    : PAW32XX_CORE_REL_WHEEL,
+                      scroll_direction);
+    *accumulator -= scroll_direction * threshold;
+  }
+}
+
+enum paw32xx_input_mode paw32xx_core_behavior_mode(int mode) {
+  if (mode < PAW32XX_MOVE || mode >= PAW32XX_INPUT_MODE_COUNT) {
+    return PAW32XX_MOVE;
+  }
+
+  return (enum paw32xx_input_mode)mode;
+}
+
+enum paw32xx_input_mode
+paw32xx_core_layer_mode(const struct paw32xx_core_layer_rule *rules,
+                        size_t count, uint8_t layer) {
+  for (size_t r = 0; r < count; r++) {
+    for (size_t i = 0; i < rules[r].len; i++) {
+      if (rules[r].layers[i] == layer) {
+        return rules[r].mode;
+      }
+    }
+  }
+
+  return PAW32XX_MOVE;
+}
+
+int16_t paw32xx_core_scroll_y(int16_t x, int16_t y, uint16_t rotation) {
+  switch (rotation) {
+  case 0:
+    return y;
+  case 90:
+    return x;
+  case 180:
+    return (y == INT16_MIN) ? INT16_MAX : -y;
+  case 270:
+    return (x == INT16_MIN) ? INT16_MAX : -x;
+  default:
+    return y;
+  }
+}
+
+void paw32xx_core_reset(struct paw32xx_core_state *state) {
+  state->scroll_accumulator = 0;
+  state->scroll_accumulator_x = 0;
+  state->scroll_accumulator_y = 0;
+}
+
+int paw32xx_core_process(const struct paw32xx_core_params *params,
+                         struct paw32xx_core_state *state,
+                         enum paw32xx_input_mode mode, int16_t x, int16_t y,
+                         struct paw32xx_core_out *out) {
+  int16_t scroll_y = paw32xx_core_scroll_y(x, y, params->rotation);
+  uint8_t divisor;
+
+  out->count = 0;
+  out->clamped = false;
+
+  switch (mode) {
+  case PAW32XX_MOVE:
+    paw32xx_core_emit(out, PAW32XX_CORE_REL_X, x);
+    paw32xx_core_emit(out, PAW32XX_CORE_REL_Y, y);
+    break;
+  case PAW32XX_SNIPE:
+    divisor = (params->snipe_divisor > 1) ? params->snipe_divisor : 1;
+    paw32xx_core_emit(out, PAW32XX_CORE_REL_X, x / divisor);
+    paw32xx_core_emit(out, PAW32XX_CORE_REL_Y, y / divisor);
+    break;
+  case PAW32XX_SCROLL:
+    paw32xx_core_scroll(out, &state->scroll_accumulator, scroll_y,
+                        params->scroll_tick, false);
+    break;
+  case PAW32XX_SCROLL_HORIZONTAL:
+    paw32xx_core_scroll(out, &state->scroll_accumulator, scroll_y,
+                        params->scroll_tick, true);
+    break;
+  case PAW32XX_SCROLL_SNIPE:
+    divisor = (params->scroll_snipe_divisor > 1) ? params->scroll_snipe_divisor : 1;
+    paw32xx_core_scroll(out, &state->scroll_accumulator, scroll_y / divisor,
+                        params->scroll_snipe_tick, false);
+    break;
+  case PAW32XX_SCROLL_HORIZONTAL_SNIPE:
+    divisor = (params->scroll_snipe_divisor > 1) ? params->scroll_snipe_divisor : 1;
+    paw32xx_core_scroll(out, &state->scroll_accumulator, scroll_y / divisor,
+                        params->scroll_snipe_tick, true);
+    break;
+  case PAW32XX_BOTHSCROLL:
+    /* X/Y swapped to get the horizontal scroll axis */
+    paw32xx_core_scroll(out, &state->scroll_accumulator_x,
+                        paw32xx_core_scroll_y(y, x, params->rotation),
+                        params->scroll_tick, true);
+    paw32xx_core_scroll(out, &state->scroll_accumulator_y, scroll_y,
+                        params->scroll_tick, false);
+    break;
+  case PAW32XX_BOTHSCROLL_SNIPE:
+    divisor = (params->scroll_snipe_divisor > 1) ? params->scroll_snipe_divisor : 1;
+    paw32xx_core_scroll(out, &state->scroll_accumulator_x,
+                        paw32xx_core_scroll_y(y, x, params->rotation) / divisor,
+                        params->scroll_snipe_tick, true);
+    paw32xx_core_scroll(out, &state->scroll_accumulator_y, scroll_y / divisor,
+                        params->scroll_snipe_tick, false);
+    break;
+  default:
+    return -EINVAL;
+  }
+
+  /* One report per sample, whichever axes it touched */
+  if (out->count > 0) {
+    out->ev[out->count - 1].sync = true;
+  }
+
+  return 0;
+}
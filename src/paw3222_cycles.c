@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_cycles.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+/* Protects the statistics of all instances; updates are a few adds */
+static struct k_spinlock paw32xx_cycles_lock;
+
+static const char *const paw32xx_cycles_names[PAW32XX_CYCLES_OP_COUNT] = {
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_MOVE] = "sample_move",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_SCROLL] = "sample_scroll",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_SCROLL_HORIZONTAL] =
+        "sample_scroll_horizontal",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_SNIPE] = "sample_snipe",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_SCROLL_SNIPE] =
+        "sample_scroll_snipe",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_SCROLL_HORIZONTAL_SNIPE] =
+        "sample_scroll_horizontal_snipe",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_BOTHSCROLL] =
+        "sample_bothscroll",
+    [PAW32XX_CYCLES_SAMPLE_BASE + PAW32XX_BOTHSCROLL_SNIPE] =
+        "sample_bothscroll_snipe",
+    [PAW32XX_CYCLES_MODE_RESOLVE] = "mode_resolve",
+    [PAW32XX_CYCLES_CPI_SWITCH] = "cpi_switch",
+    [PAW32XX_CYCLES_IDLE_ENTER] = "idle_enter",
+    [PAW32XX_CYCLES_IDLE_EXIT] = "idle_exit",
+};
+
+void paw32xx_cycles_end(const struct device *dev, int op, uint32_t start) {
+  struct paw32xx_data *data = dev->data;
+  uint32_t cyc = k_cycle_get_32() - start;
+  struct paw32xx_cycle_stat *stat;
+  k_spinlock_key_t key;
+
+  if ((unsigned int)op >= PAW32XX_CYCLES_OP_COUNT) {
+    return;
+  }
+
+  stat = &data->cycles[op];
+
+  key = k_spin_lock(&paw32xx_cycles_lock);
+  stat->count++;
+  stat->total_cyc += cyc;
+  if (cyc > stat->max_cyc) {
+    stat->max_cyc = cyc;
+  }
+  k_spin_unlock(&paw32xx_cycles_lock, key);
+}
+
+int paw32xx_cycles_get(const struct device *dev, enum paw32xx_cycle_op op,
+                       struct paw32xx_cycle_stat *stat) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  if ((unsigned int)op >= PAW32XX_CYCLES_OP_COUNT) {
+    return -EINVAL;
+  }
+
+  key = k_spin_lock(&paw32xx_cycles_lock);
+  *stat = data->cycles[op];
+  k_spin_unlock(&paw32xx_cycles_lock, key);
+
+  return 0;
+}
+
+void paw32xx_cycles_reset(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&paw32xx_cycles_lock);
+  memset(data->cycles, 0, sizeof(data->cycles));
+  k_spin_unlock(&paw32xx_cycles_lock, key);
+}
+
+const char *paw32xx_cycles_op_name(enum paw32xx_cycle_op op) {
+  if ((unsigned int)op >= PAW32XX_CYCLES_OP_COUNT) {
+    return "unknown";
+  }
+
+  return paw32xx_cycles_names[op];
+}
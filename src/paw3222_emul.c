@@ -0,0 +1,457 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222_emul.h"
+#include "paw3222_regs.h"
+
+LOG_MODULE_REGISTER(paw32xx_emul, CONFIG_ZMK_LOG_LEVEL);
+
+#define DT_DRV_COMPAT pixart_paw3222
+
+/** @brief Size of the emulated register file (0x00..PAW32XX_CPI_Y) */
+#define PAW32XX_EMUL_NUM_REGS (PAW32XX_CPI_Y + 1)
+
+/** @brief Longest SPI transfer the emulator accepts, in bytes */
+#define PAW32XX_EMUL_MAX_XFER 16
+
+/* Emulated reset values; only PRODUCT_ID1 is checked by the driver */
+#define PAW32XX_EMUL_PRODUCT_ID2 0x02
+#define PAW32XX_EMUL_CPI_DEFAULT 0x20
+
+struct paw32xx_emul_cfg {
+  struct gpio_dt_spec irq_gpio;
+};
+
+struct paw32xx_emul_data {
+  const struct emul *target;
+  struct k_spinlock lock;
+  uint8_t regs[PAW32XX_EMUL_NUM_REGS];
+  bool irq_asserted;
+  paw32xx_emul_motion_source_t source;
+  void *source_user_data;
+  struct paw32xx_emul_stats stats;
+  struct paw32xx_emul_storm storm;
+  bool storm_active;
+  struct k_timer storm_timer;
+};
+
+static void paw32xx_emul_reset(struct paw32xx_emul_data *data) {
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[PAW32XX_PRODUCT_ID1] = PRODUCT_ID_PAW32XX;
+  data->regs[PAW32XX_PRODUCT_ID2] = PAW32XX_EMUL_PRODUCT_ID2;
+  data->regs[PAW32XX_WRITE_PROTECT] = WRITE_PROTECT_ENABLE;
+  data->regs[PAW32XX_CPI_X] = PAW32XX_EMUL_CPI_DEFAULT;
+  data->regs[PAW32XX_CPI_Y] = PAW32XX_EMUL_CPI_DEFAULT;
+}
+
+static bool paw32xx_emul_powered_down(const struct paw32xx_emul_data *data) {
+  return (data->regs[PAW32XX_CONFIGURATION] & CONFIGURATION_PD_ENH) != 0;
+}
+
+/**
+ * @brief Add motion to one delta register with 8-bit saturation
+ *
+ * @return Number of counts lost to saturation
+ */
+static uint32_t paw32xx_emul_accumulate(uint8_t *reg, int16_t delta) {
+  int32_t sum = (int8_t)*reg + delta;
+  int32_t clamped = CLAMP(sum, INT8_MIN, INT8_MAX);
+
+  *reg = (uint8_t)(int8_t)clamped;
+  return (uint32_t)((sum > clamped) ? sum - clamped : clamped - sum);
+}
+
+/* Must be called with the lock held */
+static void paw32xx_emul_add_motion_locked(struct paw32xx_emul_data *data,
+                                           int16_t dx, int16_t dy) {
+  if ((dx == 0 && dy == 0) || paw32xx_emul_powered_down(data)) {
+    return;
+  }
+
+  data->stats.saturations +=
+      paw32xx_emul_accumulate(&data->regs[PAW32XX_DELTA_X], dx);
+  data->stats.saturations +=
+      paw32xx_emul_accumulate(&data->regs[PAW32XX_DELTA_Y], dy);
+}
+
+/* Must be called with the lock held; returns true if the line changed */
+static bool paw32xx_emul_update_motion(struct paw32xx_emul_data *data) {
+  bool motion = data->regs[PAW32XX_DELTA_X] != 0 ||
+                data->regs[PAW32XX_DELTA_Y] != 0;
+
+  if (motion) {
+    data->regs[PAW32XX_MOTION] |= MOTION_STATUS_MOTION;
+  } else {
+    data->regs[PAW32XX_MOTION] &= ~MOTION_STATUS_MOTION;
+  }
+
+  if (motion == data->irq_asserted) {
+    return false;
+  }
+
+  data->irq_asserted = motion;
+  if (motion) {
+    data->stats.irq_edges++;
+  }
+  return true;
+}
+
+/* Drive the motion line; called without the lock since it may run the
+ * driver's GPIO callback synchronously.
+ */
+static void paw32xx_emul_drive_irq(const struct emul *target, bool asserted) {
+  const struct paw32xx_emul_cfg *cfg = target->cfg;
+  bool active_low = (cfg->irq_gpio.dt_flags & GPIO_ACTIVE_LOW) != 0;
+  int ret;
+
+  ret = gpio_emul_input_set(cfg->irq_gpio.port, cfg->irq_gpio.pin,
+                            asserted != active_low);
+  if (ret < 0) {
+    LOG_ERR("Failed to drive motion line: %d", ret);
+  }
+}
+
+static uint8_t paw32xx_emul_read(const struct emul *target,
+                                 struct paw32xx_emul_data *data,
+                                 uint8_t addr) {
+  uint8_t val;
+
+  data->stats.reg_reads++;
+
+  if (addr >= PAW32XX_EMUL_NUM_REGS) {
+    return 0;
+  }
+
+  if (addr == PAW32XX_MOTION && data->source != NULL) {
+    int16_t dx = 0, dy = 0;
+
+    /* Each MOTION read is one sensor frame */
+    data->source(target, &dx, &dy, data->source_user_data);
+    paw32xx_emul_add_motion_locked(data, dx, dy);
+    paw32xx_emul_update_motion(data);
+  }
+
+  if (addr == PAW32XX_MOTION && data->storm_active) {
+    paw32xx_emul_add_motion_locked(data, data->storm.dx, data->storm.dy);
+    paw32xx_emul_update_motion(data);
+  }
+
+  val = data->regs[addr];
+
+  /* Delta registers clear on read */
+  if (addr == PAW32XX_DELTA_X || addr == PAW32XX_DELTA_Y) {
+    data->regs[addr] = 0;
+  }
+
+  return val;
+}
+
+static void paw32xx_emul_write(struct paw32xx_emul_data *data, uint8_t addr,
+                               uint8_t val) {
+  if (addr >= PAW32XX_EMUL_NUM_REGS || addr <= PAW32XX_DELTA_Y) {
+    /* ID, motion and delta registers are read-only */
+    data->stats.blocked_writes++;
+    return;
+  }
+
+  if (addr > PAW32XX_WRITE_PROTECT &&
+      data->regs[PAW32XX_WRITE_PROTECT] != WRITE_PROTECT_DISABLE) {
+    data->stats.blocked_writes++;
+    return;
+  }
+
+  data->stats.reg_writes++;
+
+  if (addr == PAW32XX_CONFIGURATION && (val & CONFIGURATION_RESET)) {
+    /* The reset bit self-clears and restores all defaults */
+    paw32xx_emul_reset(data);
+    data->stats.resets++;
+    return;
+  }
+
+  data->regs[addr] = val;
+
+  if (addr == PAW32XX_CONFIGURATION && (val & CONFIGURATION_PD_ENH)) {
+    /* Power down discards pending motion */
+    data->regs[PAW32XX_DELTA_X] = 0;
+    data->regs[PAW32XX_DELTA_Y] = 0;
+  }
+}
+
+static size_t paw32xx_emul_gather(const struct spi_buf_set *set, uint8_t *out,
+                                  size_t max) {
+  size_t len = 0;
+
+  if (set == NULL) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < set->count; i++) {
+    const struct spi_buf *buf = &set->buffers[i];
+
+    for (size_t j = 0; j < buf->len && len < max; j++, len++) {
+      out[len] = (buf->buf != NULL) ? ((const uint8_t *)buf->buf)[j] : 0;
+    }
+  }
+
+  return len;
+}
+
+static void paw32xx_emul_scatter(const struct spi_buf_set *set,
+                                 const uint8_t *in, size_t len) {
+  size_t pos = 0;
+
+  if (set == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < set->count && pos < len; i++) {
+    const struct spi_buf *buf = &set->buffers[i];
+    size_t n = MIN(buf->len, len - pos);
+
+    if (buf->buf != NULL) {
+      memcpy(buf->buf, &in[pos], n);
+    }
+    pos += n;
+  }
+}
+
+/**
+ * @brief Handle one SPI transfer
+ *
+ * A transfer is a sequence of two-byte frames: an address byte (SPI_WRITE
+ * set for writes) followed by the data byte, which is driven by the host
+ * for writes and by the sensor for reads.
+ */
+static int paw32xx_emul_io(const struct emul *target,
+                           const struct spi_config *config,
+                           const struct spi_buf_set *tx_bufs,
+                           const struct spi_buf_set *rx_bufs) {
+  struct paw32xx_emul_data *data = target->data;
+  uint8_t tx[PAW32XX_EMUL_MAX_XFER] = {0};
+  uint8_t rx[PAW32XX_EMUL_MAX_XFER] = {0};
+  uint8_t scratch[PAW32XX_EMUL_MAX_XFER];
+  size_t tx_len, rx_len, len;
+  k_spinlock_key_t key;
+  bool changed, asserted;
+
+  ARG_UNUSED(config);
+
+  tx_len = paw32xx_emul_gather(tx_bufs, tx, sizeof(tx));
+  rx_len = paw32xx_emul_gather(rx_bufs, scratch, sizeof(scratch));
+  len = MAX(tx_len, rx_len);
+
+  if (len == 0 || (len % 2) != 0) {
+    LOG_ERR("Unsupported transfer length %d", (int)len);
+    return -EIO;
+  }
+
+  key = k_spin_lock(&data->lock);
+  for (size_t i = 0; i < len; i += 2) {
+    uint8_t addr = tx[i] & ~SPI_WRITE;
+
+    if (tx[i] & SPI_WRITE) {
+      paw32xx_emul_write(data, addr, tx[i + 1]);
+    } else {
+      rx[i + 1] = paw32xx_emul_read(target, data, addr);
+    }
+  }
+  changed = paw32xx_emul_update_motion(data);
+  asserted = data->irq_asserted;
+  k_spin_unlock(&data->lock, key);
+
+  paw32xx_emul_scatter(rx_bufs, rx, len);
+
+  if (changed) {
+    paw32xx_emul_drive_irq(target, asserted);
+  }
+
+  return 0;
+}
+
+void paw32xx_emul_set_motion_source(const struct emul *target,
+                                    paw32xx_emul_motion_source_t source,
+                                    void *user_data) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->lock);
+  data->source = source;
+  data->source_user_data = user_data;
+  k_spin_unlock(&data->lock, key);
+}
+
+void paw32xx_emul_add_motion(const struct emul *target, int16_t dx,
+                             int16_t dy) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+  bool changed, asserted;
+
+  key = k_spin_lock(&data->lock);
+  paw32xx_emul_add_motion_locked(data, dx, dy);
+  changed = paw32xx_emul_update_motion(data);
+  asserted = data->irq_asserted;
+  k_spin_unlock(&data->lock, key);
+
+  if (changed) {
+    paw32xx_emul_drive_irq(target, asserted);
+  }
+}
+
+/* Forces a fresh edge on the motion line with new motion behind it */
+static void paw32xx_emul_storm_handler(struct k_timer *timer) {
+  struct paw32xx_emul_data *data =
+      CONTAINER_OF(timer, struct paw32xx_emul_data, storm_timer);
+  k_spinlock_key_t key;
+  bool pulse;
+
+  key = k_spin_lock(&data->lock);
+  pulse = data->storm_active && !paw32xx_emul_powered_down(data);
+  if (pulse) {
+    paw32xx_emul_add_motion_locked(data, data->storm.dx, data->storm.dy);
+    /* Release the line so that the update below counts a new edge */
+    data->irq_asserted = false;
+    paw32xx_emul_update_motion(data);
+    data->stats.storm_pulses++;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (pulse) {
+    paw32xx_emul_drive_irq(data->target, false);
+    paw32xx_emul_drive_irq(data->target, true);
+  }
+}
+
+void paw32xx_emul_storm_start(const struct emul *target,
+                              const struct paw32xx_emul_storm *storm) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+
+  k_timer_stop(&data->storm_timer);
+
+  key = k_spin_lock(&data->lock);
+  data->storm = *storm;
+  data->storm_active = true;
+  k_spin_unlock(&data->lock, key);
+
+  /* Get the first frame going even if the line is idle */
+  paw32xx_emul_add_motion(target, storm->dx, storm->dy);
+
+  if (storm->irq_period_us > 0) {
+    k_timer_start(&data->storm_timer, K_USEC(storm->irq_period_us),
+                  K_USEC(storm->irq_period_us));
+  }
+}
+
+void paw32xx_emul_storm_stop(const struct emul *target) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+
+  k_timer_stop(&data->storm_timer);
+
+  key = k_spin_lock(&data->lock);
+  data->storm_active = false;
+  k_spin_unlock(&data->lock, key);
+}
+
+int paw32xx_emul_reg_get(const struct emul *target, uint8_t addr,
+                         uint8_t *val) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+
+  if (addr >= PAW32XX_EMUL_NUM_REGS) {
+    return -EINVAL;
+  }
+
+  key = k_spin_lock(&data->lock);
+  *val = data->regs[addr];
+  k_spin_unlock(&data->lock, key);
+
+  return 0;
+}
+
+int paw32xx_emul_reg_set(const struct emul *target, uint8_t addr,
+                         uint8_t val) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+  bool changed, asserted;
+
+  if (addr >= PAW32XX_EMUL_NUM_REGS) {
+    return -EINVAL;
+  }
+
+  key = k_spin_lock(&data->lock);
+  data->regs[addr] = val;
+  changed = paw32xx_emul_update_motion(data);
+  asserted = data->irq_asserted;
+  k_spin_unlock(&data->lock, key);
+
+  if (changed) {
+    paw32xx_emul_drive_irq(target, asserted);
+  }
+
+  return 0;
+}
+
+void paw32xx_emul_get_stats(const struct emul *target,
+                            struct paw32xx_emul_stats *stats) {
+  struct paw32xx_emul_data *data = target->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->lock);
+  *stats = data->stats;
+  k_spin_unlock(&data->lock, key);
+}
+
+static const struct spi_emul_api paw32xx_emul_api = {
+    .io = paw32xx_emul_io,
+};
+
+static int paw32xx_emul_init(const struct emul *target,
+                             const struct device *parent) {
+  const struct paw32xx_emul_cfg *cfg = target->cfg;
+  struct paw32xx_emul_data *data = target->data;
+
+  ARG_UNUSED(parent);
+
+  paw32xx_emul_reset(data);
+  data->irq_asserted = false;
+  data->target = target;
+  k_timer_init(&data->storm_timer, paw32xx_emul_storm_handler, NULL);
+
+  if (!gpio_is_ready_dt(&cfg->irq_gpio)) {
+    LOG_ERR("Motion line GPIO is not ready");
+    return -ENODEV;
+  }
+
+  /* Start with the (active low) motion line released */
+  paw32xx_emul_drive_irq(target, false);
+
+  return 0;
+}
+
+#define PAW32XX_EMUL(n)                                                        \
+  static const struct paw32xx_emul_cfg paw32xx_emul_cfg_##n = {                \
+      .irq_gpio = GPIO_DT_SPEC_INST_GET(n, irq_gpios),                         \
+  };                                                                           \
+  static struct paw32xx_emul_data paw32xx_emul_data_##n;                       \
+  EMUL_DT_INST_DEFINE(n, paw32xx_emul_init, &paw32xx_emul_data_##n,            \
+                      &paw32xx_emul_cfg_##n, &paw32xx_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(PAW32XX_EMUL)
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/events/layer_state_changed.h>
+
+#include "paw3222.h"
+#include "paw3222_event.h"
+#include "paw3222_input.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+ZMK_EVENT_IMPL(zmk_paw32xx_mode_changed);
+
+#define DT_DRV_COMPAT pixart_paw3222
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+
+#define PAW32XX_DEVICE_ENTRY(n) DEVICE_DT_INST_GET(n),
+
+static const struct device *const paw32xx_devices[] = {
+    DT_INST_FOREACH_STATUS_OKAY(PAW32XX_DEVICE_ENTRY)};
+
+/**
+ * @brief Re-resolve the effective mode of every instance on layer changes
+ *
+ * Layer-based switching has no other hook that runs when the active layer
+ * changes, so without this listener a layer-driven mode change would only
+ * become visible on the next motion sample.
+ */
+static int paw32xx_layer_state_listener(const zmk_event_t *eh) {
+  ARG_UNUSED(eh);
+
+  for (size_t i = 0; i < ARRAY_SIZE(paw32xx_devices); i++) {
+    if (device_is_ready(paw32xx_devices[i])) {
+      paw32xx_update_effective_mode(paw32xx_devices[i]);
+    }
+  }
+
+  return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(paw32xx_mode, paw32xx_layer_state_listener);
+ZMK_SUBSCRIPTION(paw32xx_mode, zmk_layer_state_changed);
+
+#endif // DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
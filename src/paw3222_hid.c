@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid.h>
+
+#include "paw3222_core.h"
+#include "paw3222_hid.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+bool paw32xx_hid_report(const struct paw32xx_core_out *out) {
+  int32_t rel[PAW32XX_CORE_REL_HWHEEL + 1] = {0};
+  int ret;
+
+  if (out->count == 0) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < out->count; i++) {
+    rel[out->ev[i].code] += out->ev[i].value;
+  }
+
+  zmk_hid_mouse_movement_set(
+      CLAMP(rel[PAW32XX_CORE_REL_X], INT16_MIN, INT16_MAX),
+      CLAMP(rel[PAW32XX_CORE_REL_Y], INT16_MIN, INT16_MAX));
+  zmk_hid_mouse_scroll_set(
+      CLAMP(rel[PAW32XX_CORE_REL_HWHEEL], INT8_MIN, INT8_MAX),
+      CLAMP(rel[PAW32XX_CORE_REL_WHEEL], INT8_MIN, INT8_MAX));
+  ret = zmk_endpoints_send_mouse_report();
+  if (ret < 0) {
+    /* Disconnected endpoints refuse every report; not worth a warning */
+    LOG_DBG("Mouse report not sent: %d", ret);
+  }
+
+  /* Relative fields: the next report from any source must not repeat them */
+  zmk_hid_mouse_scroll_set(0, 0);
+  zmk_hid_mouse_movement_set(0, 0);
+  return true;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* No Zephyr includes: this file is also built for the host tools */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "paw3222_idle.h"
+
+void paw32xx_idle_init(struct paw32xx_idle_sm *sm, bool reduced_scan) {
+  sm->idle = false;
+  sm->expired = false;
+  sm->reduced_scan = reduced_scan;
+  sm->fault = false;
+  sm->probe = false;
+  sm->woke = false;
+}
+
+/* Leaves idle; only valid from the work queue */
+static uint16_t paw32xx_idle_wake(struct paw32xx_idle_sm *sm) {
+  sm->idle = false;
+  sm->expired = false;
+  sm->woke = true;
+
+  return PAW32XX_IDLE_ACT_WAKE | PAW32XX_IDLE_ACT_ARM_TIMEOUT |
+         (sm->reduced_scan ? PAW32XX_IDLE_ACT_POLL_REDUCED
+                           : PAW32XX_IDLE_ACT_POLL);
+}
+
+uint16_t paw32xx_idle_step(struct paw32xx_idle_sm *sm,
+                           enum paw32xx_idle_event ev) {
+  switch (ev) {
+  case PAW32XX_IDLE_EV_IRQ:
+    /* Interrupt context: defer everything, including the wake, to the work */
+    return PAW32XX_IDLE_ACT_IRQ_OFF | PAW32XX_IDLE_ACT_POLL_STOP |
+           PAW32XX_IDLE_ACT_RUN;
+
+  case PAW32XX_IDLE_EV_POLL:
+    return PAW32XX_IDLE_ACT_RUN;
+
+  case PAW32XX_IDLE_EV_RUN:
+    if (sm->idle && sm->fault) {
+      /* Fallback probe: wake for one read, decided by SAMPLE or QUIET */
+      sm->idle = false;
+      sm->probe = true;
+      return PAW32XX_IDLE_ACT_WAKE;
+    }
+    /* Wake before the sensor is read */
+    return sm->idle ? paw32xx_idle_wake(sm) : 0;
+
+  case PAW32XX_IDLE_EV_SAMPLE:
+    if (sm->idle) {
+      return paw32xx_idle_wake(sm);
+    }
+    sm->probe = false;
+    sm->expired = false;
+    /* The wake's own sample must not replace its reduced first poll */
+    if (sm->woke) {
+      sm->woke = false;
+      return PAW32XX_IDLE_ACT_ARM_TIMEOUT |
+             (sm->reduced_scan ? PAW32XX_IDLE_ACT_POLL_REDUCED
+                               : PAW32XX_IDLE_ACT_POLL);
+    }
+    return PAW32XX_IDLE_ACT_ARM_TIMEOUT | PAW32XX_IDLE_ACT_POLL;
+
+  case PAW32XX_IDLE_EV_QUIET:
+  case PAW32XX_IDLE_EV_PHANTOM:
+    sm->woke = false;
+    if (sm->fault) {
+      if (sm->probe) {
+        /* Nothing found by the probe: straight back to sleep */
+        sm->idle = true;
+        return PAW32XX_IDLE_ACT_SLEEP | PAW32XX_IDLE_ACT_POLL_FALLBACK;
+      }
+      return PAW32XX_IDLE_ACT_POLL_FALLBACK;
+    }
+    /* A phantom leaves the idle timeout alone so a stuck line cannot hold
+     * the sensor awake; the poll lets the line monitor see it again */
+    return ev == PAW32XX_IDLE_EV_QUIET ? PAW32XX_IDLE_ACT_IRQ_ON
+                                       : PAW32XX_IDLE_ACT_POLL;
+
+  case PAW32XX_IDLE_EV_FAULT:
+    sm->fault = true;
+    return PAW32XX_IDLE_ACT_IRQ_OFF | PAW32XX_IDLE_ACT_POLL_FALLBACK;
+
+  case PAW32XX_IDLE_EV_CLEAR:
+    sm->fault = false;
+    if (sm->probe) {
+      sm->probe = false;
+      sm->idle = true;
+      return PAW32XX_IDLE_ACT_POLL_STOP | PAW32XX_IDLE_ACT_SLEEP |
+             PAW32XX_IDLE_ACT_IRQ_ON | PAW32XX_IDLE_ACT_RECHECK;
+    }
+    return PAW32XX_IDLE_ACT_POLL_STOP | PAW32XX_IDLE_ACT_IRQ_ON |
+           PAW32XX_IDLE_ACT_RECHECK;
+
+  case PAW32XX_IDLE_EV_EXPIRE:
+    sm->expired = true;
+    return PAW32XX_IDLE_ACT_TIMEOUT_WORK;
+
+  case PAW32XX_IDLE_EV_TIMEOUT:
+    /*
+     * A sample may have re-armed the timer between the expiry and this
+     * work item (the timer fired while the motion work was running)
+     */
+    if (sm->idle || !sm->expired) {
+      return 0;
+    }
+    sm->idle = true;
+    sm->expired = false;
+    if (sm->fault) {
+      return PAW32XX_IDLE_ACT_POLL_STOP | PAW32XX_IDLE_ACT_SLEEP |
+             PAW32XX_IDLE_ACT_POLL_FALLBACK;
+    }
+    /*
+     * Pending motion work is left alone: it runs after this on the same
+     * queue and wakes the sensor again. The interrupt may still be off
+     * from an edge whose work has not run yet, and an edge that arrived
+     * while it was off is gone, so re-enable it and look at the line.
+     */
+    return PAW32XX_IDLE_ACT_POLL_STOP | PAW32XX_IDLE_ACT_SLEEP |
+           PAW32XX_IDLE_ACT_IRQ_ON | PAW32XX_IDLE_ACT_RECHECK;
+
+  default:
+    return 0;
+  }
+}
@@ -6,8 +6,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/input/input.h>
@@ -28,10 +30,23 @@
 #endif
 
 #include "paw3222.h"
+#include "paw3222_core.h"
+#include "paw3222_cycles.h"
+#include "paw3222_event.h"
+#include "paw3222_hid.h"
+#include "paw3222_idle.h"
 #include "paw3222_input.h"
+#include "paw3222_latency.h"
+#include "paw3222_line.h"
+#include "paw3222_pipeline.h"
 #include "paw3222_power.h"
+#include "paw3222_recorder.h"
 #include "paw3222_regs.h"
+#include "paw3222_sensor.h"
+#include "paw3222_snapshot.h"
 #include "paw3222_spi.h"
+#include "paw3222_trace.h"
+#include "paw3222_tracing.h"
 
 /* The primary module registration lives in paw3222.c; other compilation units
  * must declare the module to avoid multiple definition of the log_const_* symbol.
@@ -50,232 +65,569 @@ LOG_MODULE_DECLARE(paw32xx);
 /* Per-device idle timer/flag now live in struct paw32xx_data */
 
 void paw32xx_idle_timeout_handler(struct k_timer *timer);
-void paw32xx_idle_enter(const struct device *dev);
-void paw32xx_idle_exit(const struct device *dev);
 
 extern struct k_timer bothscroll_key_timer;
 
+#ifndef CONFIG_PAW3222_HID_DIRECT
+/* Input codes of enum paw32xx_core_code */
+static const uint16_t paw32xx_core_codes[] = {
+    [PAW32XX_CORE_REL_X] = INPUT_REL_X,
+    [PAW32XX_CORE_REL_Y] = INPUT_REL_Y,
+    [PAW32XX_CORE_REL_WHEEL] = INPUT_REL_WHEEL,
+    [PAW32XX_CORE_REL_HWHEEL] = INPUT_REL_HWHEEL,
+};
+#endif
+
 /**
- * @brief Calculate absolute value of int16_t (memory optimized)
+ * @brief Queue the motion work handler
  *
- * Computes the absolute value of a 16-bit signed integer without using
- * the standard library abs() function. This inline function is optimized
+ * Remembers when the first of possibly several coalesced submissions
+ * happened so the handler can account the work queue delay.
  *
- * @param value Input signed 16-bit integer
- * 
- * @return Absolute value of the input
- * 
- * @note This function handles the INT16_MIN case correctly by returning
- *       the positive equivalent without overflow issues.
+ * @param data PAW3222 runtime data
  */
-static inline int16_t abs_int16(int16_t value) {
-  return (value < 0) ? -value : value;
+static inline void paw32xx_submit_motion_work(struct paw32xx_data *data) {
+#ifdef CONFIG_PAW3222_STATS
+  if (!data->stats.submit_pending) {
+    data->stats.submit_cyc = k_cycle_get_32();
+    data->stats.submit_pending = true;
+  }
+#endif
+  paw32xx_pipeline_submit(&data->motion_work);
 }
 
 /**
- * @brief Safely add to scroll accumulator with overflow protection
+ * @brief Account one synced report
  *
- * Adds a delta value to the scroll accumulator while preventing overflow.
- * Clamps the result to INT16_MIN/INT16_MAX range and logs warnings on overflow.
+ * @param dev PAW3222 device pointer
+ * @param start Cycle count before the report was handed on
+ */
+static inline void paw32xx_report_done(const struct device *dev,
+                                       uint32_t start) {
+#ifdef CONFIG_PAW3222_STATS
+  struct paw32xx_data *data = dev->data;
+  uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+#else
+  ARG_UNUSED(start);
+#endif
+
+  paw32xx_latency_mark_report(dev);
+#ifdef CONFIG_PAW3222_STATS
+  data->stats.reports++;
+  data->stats.report_block_max_us = MAX(data->stats.report_block_max_us, us);
+  if (us >= PAW32XX_REPORT_STALL_US) {
+    data->stats.report_stalls++;
+  }
+#endif
+}
+
+#ifdef CONFIG_PAW3222_HID_DIRECT
+/**
+ * @brief Report the events of one sample straight to the HID endpoint
  *
- * @param accumulator Pointer to the current accumulator value
- * @param delta Delta value to add
- * 
- * @note Modifies the accumulator value in place
+ * @param dev PAW3222 device pointer
+ * @param out Events of the sample
  */
-static inline void add_to_scroll_accumulator(int16_t *accumulator, int16_t delta) {
-  int32_t temp = (int32_t)*accumulator + delta;
-  if (temp > INT16_MAX) {
-    LOG_WRN("Scroll accumulator overflow: %d, clamped to %d", temp, INT16_MAX);
-    *accumulator = INT16_MAX;
-  } else if (temp < INT16_MIN) {
-    LOG_WRN("Scroll accumulator underflow: %d, clamped to %d", temp, INT16_MIN);
-    *accumulator = INT16_MIN;
-  } else {
-    *accumulator = (int16_t)temp;
+static inline void paw32xx_report_sample(const struct device *dev,
+                                         const struct paw32xx_core_out *out) {
+  uint32_t start = k_cycle_get_32();
+
+  /* No report: the sync mark would stay pending for a later sample */
+  if (out->count == 0) {
+    return;
   }
+
+  paw32xx_latency_mark_sync(dev);
+  paw32xx_hid_report(out);
+  paw32xx_report_done(dev, start);
+  paw32xx_latency_mark_hid(dev);
+}
+#else
+/**
+ * @brief Report one pipeline event
+ *
+ * Every event waits for room in the input queue (K_FOREVER): one dropped
+ * from a full queue would lose part of its report, such as one axis of a
+ * BOTHSCROLL sample.
+ *
+ * @param dev PAW3222 device pointer
+ * @param ev Event to report
+ */
+static inline void paw32xx_report_event(const struct device *dev,
+                                        const struct paw32xx_core_event *ev) {
+  if (ev->sync) {
+    paw32xx_latency_mark_sync(dev);
+  }
+  input_report_rel(dev, paw32xx_core_codes[ev->code], ev->value, ev->sync,
+                   K_FOREVER);
 }
 
 /**
- * @brief Process scroll input and generate scroll events
+ * @brief Report the events of one sample through the input subsystem
  *
- * Accumulates scroll movement and generates scroll events when threshold is reached.
- * Handles both vertical and horizontal scrolling based on the input type.
+ * The core syncs only the last event, so a sample with events is one
+ * report; with statistics enabled the time all of its events spent
+ * waiting is accounted.
  *
- * @param dev Device pointer for input reporting
- * @param accumulator Pointer to scroll accumulator
- * @param scroll_delta Scroll movement delta
- * @param threshold Threshold for triggering scroll events
- * @param is_horizontal true for horizontal scroll, false for vertical
+ * @param dev PAW3222 device pointer
+ * @param out Events of the sample
  */
-static void process_scroll_input(const struct device *dev, int16_t *accumulator, 
-                                int16_t scroll_delta, uint8_t threshold, bool is_horizontal) {
-  add_to_scroll_accumulator(accumulator, scroll_delta);
-  
-  if (abs_int16(*accumulator) >= threshold) {
-    int16_t scroll_direction = (*accumulator > 0) ? 1 : -1;
-    uint16_t input_code = is_horizontal ? INPUT_REL_HWHEEL : INPUT_REL_WHEEL;
-    
-    input_report_rel(dev, input_code, scroll_direction, true, K_FOREVER);
-    *accumulator -= scroll_direction * threshold;
+static inline void paw32xx_report_sample(const struct device *dev,
+                                         const struct paw32xx_core_out *out) {
+  uint32_t start = k_cycle_get_32();
+
+  for (uint8_t i = 0; i < out->count; i++) {
+    paw32xx_report_event(dev, &out->ev[i]);
   }
+  if (out->count > 0) {
+    paw32xx_report_done(dev, start);
+  }
+}
+#endif
+
+enum paw32xx_current_mode paw32xx_mode_effective(const struct device *dev) {
+  const struct paw32xx_data *data = dev->data;
+
+  if (data->mode_stack_len > 0) {
+    return data->mode_stack[data->mode_stack_len - 1].mode;
+  }
+  return data->current_mode;
+}
+
+void paw32xx_mode_set_effective(const struct device *dev,
+                                enum paw32xx_current_mode mode) {
+  struct paw32xx_data *data = dev->data;
+
+  if (data->mode_stack_len > 0) {
+    data->mode_stack[data->mode_stack_len - 1].mode = mode;
+  } else {
+    data->current_mode = mode;
+  }
+}
+
+int paw32xx_mode_push(const struct device *dev, enum paw32xx_current_mode mode,
+                      uint32_t position) {
+  struct paw32xx_data *data = dev->data;
+
+  if (data->mode_stack_len >= ARRAY_SIZE(data->mode_stack)) {
+    LOG_WRN("Mode stack full, ignoring momentary mode %d", mode);
+    return -ENOMEM;
+  }
+
+  data->mode_stack[data->mode_stack_len].mode = mode;
+  data->mode_stack[data->mode_stack_len].position = position;
+  data->mode_stack_len++;
+  return 0;
+}
+
+int paw32xx_mode_pop(const struct device *dev, uint32_t position) {
+  struct paw32xx_data *data = dev->data;
+
+  /* Search from the top: the most recent press of a position wins */
+  for (int i = data->mode_stack_len - 1; i >= 0; i--) {
+    if (data->mode_stack[i].position != position) {
+      continue;
+    }
+    for (int j = i; j < data->mode_stack_len - 1; j++) {
+      data->mode_stack[j] = data->mode_stack[j + 1];
+    }
+    data->mode_stack_len--;
+    return 0;
+  }
+
+  return -ENOENT;
 }
 
 enum paw32xx_input_mode
 get_input_mode_for_current_layer(const struct device *dev) {
   const struct paw32xx_config *cfg = dev->config;
+
+  // Check if using behavior-based switching instead of layer-based
+  if (cfg->switch_method != PAW32XX_SWITCH_LAYER) {
+    // Convert the effective (top of stack) mode to input mode enum
+    return paw32xx_core_behavior_mode(paw32xx_mode_effective(dev));
+  }
+
+  // Original layer-based switching logic, most specific mode first
+  const struct paw32xx_core_layer_rule rules[] = {
+      {PAW32XX_SCROLL_HORIZONTAL_SNIPE, cfg->scroll_horizontal_snipe_layers,
+       cfg->scroll_horizontal_snipe_layers_len},
+      {PAW32XX_SCROLL_SNIPE, cfg->scroll_snipe_layers,
+       cfg->scroll_snipe_layers_len},
+      {PAW32XX_SCROLL_HORIZONTAL, cfg->scroll_horizontal_layers,
+       cfg->scroll_horizontal_layers_len},
+      {PAW32XX_SCROLL, cfg->scroll_layers, cfg->scroll_layers_len},
+      {PAW32XX_SNIPE, cfg->snipe_layers, cfg->snipe_layers_len},
+      {PAW32XX_BOTHSCROLL, cfg->bothscroll_layers, cfg->bothscroll_layers_len},
+  };
+
+  return paw32xx_core_layer_mode(rules, ARRAY_SIZE(rules),
+                                 zmk_keymap_highest_layer_active());
+}
+
+/* The input and current mode enums share their ordering */
+BUILD_ASSERT((int)PAW32XX_MODE_MOVE == (int)PAW32XX_MOVE &&
+             (int)PAW32XX_MODE_SCROLL == (int)PAW32XX_SCROLL &&
+             (int)PAW32XX_MODE_SCROLL_HORIZONTAL == (int)PAW32XX_SCROLL_HORIZONTAL &&
+             (int)PAW32XX_MODE_SNIPE == (int)PAW32XX_SNIPE &&
+             (int)PAW32XX_MODE_SCROLL_SNIPE == (int)PAW32XX_SCROLL_SNIPE &&
+             (int)PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE == (int)PAW32XX_SCROLL_HORIZONTAL_SNIPE &&
+             (int)PAW32XX_MODE_BOTHSCROLL == (int)PAW32XX_BOTHSCROLL &&
+             (int)PAW32XX_MODE_BOTHSCROLL_SNIPE == (int)PAW32XX_BOTHSCROLL_SNIPE,
+             "paw32xx_current_mode and paw32xx_input_mode must stay in sync");
+
+static void paw32xx_publish_mode(const struct device *dev) {
+  const struct paw32xx_data *data = dev->data;
+
+  paw32xx_trace_mode(dev, data->input_mode, data->profile);
+  raise_zmk_paw32xx_mode_changed((struct zmk_paw32xx_mode_changed){
+      .dev = dev,
+      .mode = (enum paw32xx_current_mode)data->input_mode,
+      .profile = data->profile,
+  });
+}
+
+void paw32xx_update_effective_mode(const struct device *dev) {
   struct paw32xx_data *data = dev->data;
+  enum paw32xx_input_mode input_mode;
+  uint32_t cyc = paw32xx_cycles_begin();
 
-// LOG_INF("cfg->switch_method=%d, data->current_mode=%d", cfg->switch_method, data->current_mode); // XYSCROLL_DEBUG_LOG
+  PAW32XX_TRACING_ENTER(mode, data->input_mode);
+  input_mode = get_input_mode_for_current_layer(dev);
+  PAW32XX_TRACING_EXIT(mode, input_mode);
+  paw32xx_cycles_end(dev, PAW32XX_CYCLES_MODE_RESOLVE, cyc);
 
-// enum paw32xx_mode_switch_method => cfg->switch_method
-//  0: PAW32XX_SWITCH_LAYER,  /**< Original layer-based switching using ZMK layers */
-//  1: PAW32XX_SWITCH_TOGGLE, /**< Toggle key based switching using behavior API *
+  if (input_mode == data->input_mode) {
+    return;
+  }
 
-// enum paw32xx_current_mode => data->current_mode
-//  0: PAW32XX_MODE_MOVE,                    /**< Standard cursor movement mode */
-//  1: PAW32XX_MODE_SCROLL,                  /**< Vertical scrolling mode */
-//  2: PAW32XX_MODE_SCROLL_HORIZONTAL,       /**< Horizontal scrolling mode */
-//  3: PAW32XX_MODE_SNIPE,                   /**< High-precision cursor movement mode */
-//  4: PAW32XX_MODE_SCROLL_SNIPE,            /**< High-precision vertical scrolling mode */
-//  5: PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE, /**< High-precision horizontal scrolling mode */
-//  6: PAW32XX_MODE_BOTHSCROLL,              /**< XY同時スクロールモード */
-  
-//LOG_INF("start of get_input_mode_for_current_layer"); // XYSCROLL_DEBUG_LOG
+  /* The motion handler only reads this cached value */
+  data->input_mode = input_mode;
+  PAW32XX_STAT_INC(data, mode_changes);
+  paw32xx_publish_mode(dev);
+}
 
-  // Check if using behavior-based switching instead of layer-based
-  if (cfg->switch_method != PAW32XX_SWITCH_LAYER) {
-    // Convert current mode state to input mode enum
-    switch (data->current_mode) {
-    case PAW32XX_MODE_SCROLL:
-      return PAW32XX_SCROLL;
-    case PAW32XX_MODE_SCROLL_HORIZONTAL:
-      return PAW32XX_SCROLL_HORIZONTAL;
-    case PAW32XX_MODE_SNIPE:
-      return PAW32XX_SNIPE;
-    case PAW32XX_MODE_SCROLL_SNIPE:
-      LOG_INF("switch (data->current_mode)=PAW32XX_SCROLL_SNIPE"); // XYSCROLL_DEBUG_LOG
-      return PAW32XX_SCROLL_SNIPE;
-    case PAW32XX_MODE_SCROLL_HORIZONTAL_SNIPE:
-      return PAW32XX_SCROLL_HORIZONTAL_SNIPE;
-    case PAW32XX_MODE_BOTHSCROLL:
-      /* XYSCROLL_DEBUG_LOG */
-//    LOG_INF("data->current_mode=%d", data->current_mode); // XYSCROLL_DEBUG_LOG
-//    LOG_INF("switch (data->current_mode)=PAW32XX_BOTHSCROLL"); // XYSCROLL_DEBUG_LOG
-      return PAW32XX_BOTHSCROLL;
-    default:
-//    LOG_INF("switch (data->current_mode)=PAW32XX_MOVE"); // XYSCROLL_DEBUG_LOG
-      return PAW32XX_MOVE;
-    }
+/**
+ * @brief Write the CPI required by an input mode if it is not already active
+ *
+ * @param dev PAW3222 device pointer
+ * @param input_mode Input mode the next sample will be processed in
+ */
+static void paw32xx_switch_cpi(const struct device *dev,
+                               enum paw32xx_input_mode input_mode) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  int16_t target_cpi = data->tune.res_cpi;
+  int ret;
+
+  if (data->profile > 0 && data->profile <= cfg->cpi_profiles_len) {
+    target_cpi = cfg->cpi_profiles[data->profile - 1];
   }
 
-//LOG_INF("end of switch (data->current_mode)"); // XYSCROLL_DEBUG_LOG
-  
-  // Original layer-based switching logic
-  uint8_t curr_layer = zmk_keymap_highest_layer_active();
-/*
-  LOG_INF("curr_layer=%d", curr_layer); // XYSCROLL_DEBUG_LOG layer_4がアクティブになっているか
-  LOG_INF("cfg->snipe_layers=%d,      cfg->snipe_layers_len=%d",      cfg->snipe_layers,      cfg->snipe_layers_len);       // XYSCROLL_DEBUG_LOG
-  LOG_INF("cfg->scroll_layers=%d,     cfg->scroll_layers_len=%d",     cfg->scroll_layers,     cfg->scroll_layers_len);      // XYSCROLL_DEBUG_LOG
-  LOG_INF("cfg->bothscroll_layers=%d, cfg->bothscroll_layers_len=%d", cfg->bothscroll_layers, cfg->bothscroll_layers_len);  // XYSCROLL_DEBUG_LOG
-*/
-  // High-precision horizontal scroll (snipe)
-  if (cfg->scroll_horizontal_snipe_layers &&
-      cfg->scroll_horizontal_snipe_layers_len > 0) {
-    for (size_t i = 0; i < cfg->scroll_horizontal_snipe_layers_len; i++) {
-      if (curr_layer == cfg->scroll_horizontal_snipe_layers[i]) {
-        return PAW32XX_SCROLL_HORIZONTAL_SNIPE;
-      }
-    }
+  if (input_mode == PAW32XX_SNIPE) {
+    // Use snipe_cpi if configured, otherwise use default from Kconfig
+    target_cpi = (data->tune.snipe_cpi > 0) ? data->tune.snipe_cpi
+                                            : CONFIG_PAW3222_SNIPE_CPI;
   }
-  // High-precision vertical scroll (snipe)
-  if (cfg->scroll_snipe_layers && cfg->scroll_snipe_layers_len > 0) {
-    for (size_t i = 0; i < cfg->scroll_snipe_layers_len; i++) {
-      if (curr_layer == cfg->scroll_snipe_layers[i]) {
-        return PAW32XX_SCROLL_SNIPE;
-      }
+  if (data->current_cpi != target_cpi) {
+    uint32_t cyc = paw32xx_cycles_begin();
+
+    PAW32XX_TRACING_ENTER(cpi, target_cpi);
+    ret = paw32xx_set_resolution(dev, target_cpi);
+    PAW32XX_TRACING_EXIT(cpi, ret);
+    paw32xx_cycles_end(dev, PAW32XX_CYCLES_CPI_SWITCH, cyc);
+    if (ret == 0) {
+      data->current_cpi = target_cpi;
+      paw32xx_trace_cpi(dev, target_cpi);
+      PAW32XX_STAT_INC(data, cpi_writes);
+    } else {
+      LOG_WRN("Failed to set CPI to %d: %d", target_cpi, ret);
     }
   }
-  // Horizontal scroll
-  if (cfg->scroll_horizontal_layers && cfg->scroll_horizontal_layers_len > 0) {
-    for (size_t i = 0; i < cfg->scroll_horizontal_layers_len; i++) {
-      if (curr_layer == cfg->scroll_horizontal_layers[i]) {
-        return PAW32XX_SCROLL_HORIZONTAL;
-      }
-    }
+}
+
+void paw32xx_apply_mode(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  /*
+   * Drop partial scroll travel accumulated in the previous mode. Callers
+   * run on any thread, so the processing stage clears the accumulators
+   * itself, and the CPI is written next to the motion work.
+   */
+  atomic_set(&data->core_reset, 1);
+  paw32xx_pipeline_submit(&data->tune_work);
+}
+
+int paw32xx_set_profile(const struct device *dev, uint8_t profile) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+
+  if (profile > cfg->cpi_profiles_len) {
+    LOG_ERR("Profile %d not configured (%d profiles)", profile,
+            (int)cfg->cpi_profiles_len + 1);
+    return -EINVAL;
   }
-  // Vertical scroll
-  if (cfg->scroll_layers && cfg->scroll_layers_len > 0) {
-    for (size_t i = 0; i < cfg->scroll_layers_len; i++) {
-      if (curr_layer == cfg->scroll_layers[i]) {
-        return PAW32XX_SCROLL;
-      }
-    }
+
+  if (profile == data->profile) {
+    return 0;
   }
-  // High-precision cursor movement (snipe)
-  if (cfg->snipe_layers && cfg->snipe_layers_len > 0) {
-    for (size_t i = 0; i < cfg->snipe_layers_len; i++) {
-      if (curr_layer == cfg->snipe_layers[i]) {
-        return PAW32XX_SNIPE;
-      }
-    }
+
+  data->profile = profile;
+  paw32xx_pipeline_submit(&data->tune_work);
+  paw32xx_publish_mode(dev);
+  return 0;
+}
+
+const char *paw32xx_mode_name(enum paw32xx_current_mode mode) {
+  static const char *const names[PAW32XX_MODE_COUNT] = {
+      "MOVE",       "SCROLL",       "SCROLL_HORIZONTAL",
+      "SNIPE",      "SCROLL_SNIPE", "SCROLL_HORIZONTAL_SNIPE",
+      "BOTHSCROLL", "BOTHSCROLL_SNIPE",
+  };
+
+  if ((unsigned int)mode >= PAW32XX_MODE_COUNT) {
+    return "UNKNOWN";
   }
-    // XY同時スクロール（BOTHSCROLL）
-    if (cfg->bothscroll_layers && cfg->bothscroll_layers_len > 0) {
-//    LOG_INF("cfg->bothscroll_layers && cfg->bothscroll_layers_len > 0"); // XYSCROLL_DEBUG_LOG
-      for (size_t i = 0; i < cfg->bothscroll_layers_len; i++) {
-//      LOG_INF("size_t i = 0; i < cfg->bothscroll_layers_len; i++"); // XYSCROLL_DEBUG_LOG
-        if (curr_layer == cfg->bothscroll_layers[i]) {
-//        LOG_INF("curr_layer == cfg->bothscroll_layers[i]"); // XYSCROLL_DEBUG_LOG
-          return PAW32XX_BOTHSCROLL;
-        }
-      }
+
+  return names[mode];
+}
+
+void paw32xx_tuning_init(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+
+  data->tune.res_cpi = cfg->res_cpi;
+  data->tune.snipe_cpi = cfg->snipe_cpi;
+  data->tune.core.rotation = cfg->rotation;
+  data->tune.core.snipe_divisor = cfg->snipe_divisor;
+  data->tune.core.scroll_snipe_divisor = cfg->scroll_snipe_divisor;
+  data->tune.core.scroll_tick = cfg->scroll_tick;
+  data->tune.core.scroll_snipe_tick = cfg->scroll_snipe_tick;
+  data->tune.poll_ms = PAW32XX_POLL_INTERVAL_MS;
+  data->tune.reduced_scan_ms = CONFIG_PAW3222_REDUCED_SCAN_MS;
+  data->tune.idle_timeout_s = CONFIG_PAW3222_IDLE_TIMEOUT_SECONDS;
+}
+
+void paw32xx_tuning_work_handler(struct k_work *work) {
+  struct paw32xx_data *data =
+      CONTAINER_OF(work, struct paw32xx_data, tune_work);
+
+  /* Asleep: the wake writes the CPI of whatever mode is current by then */
+  if (data->idle_sm.idle) {
+    return;
+  }
+
+  /* Same work queue as the motion work: never runs in the middle of it */
+  paw32xx_switch_cpi(data->dev, data->input_mode);
+}
+
+struct paw32xx_queue_call_ctx {
+  struct k_work work;
+  const struct device *dev;
+  paw32xx_queue_fn_t fn;
+  void *arg;
+  int ret;
+};
+
+static void paw32xx_queue_call_handler(struct k_work *work) {
+  struct paw32xx_queue_call_ctx *ctx =
+      CONTAINER_OF(work, struct paw32xx_queue_call_ctx, work);
+
+  ctx->ret = ctx->fn(ctx->dev, ctx->arg);
+}
+
+int paw32xx_queue_call(const struct device *dev, paw32xx_queue_fn_t fn,
+                       void *arg) {
+  struct k_work_q *queue = paw32xx_pipeline_queue();
+  struct paw32xx_queue_call_ctx ctx = {
+      .dev = dev,
+      .fn = fn,
+      .arg = arg,
+  };
+  struct k_work_sync sync;
+  int ret;
+
+  if (k_current_get() == k_work_queue_thread_get(queue)) {
+    /* Already serialized with the motion work; waiting would deadlock */
+    return fn(dev, arg);
+  }
+
+  k_work_init(&ctx.work, paw32xx_queue_call_handler);
+  ret = k_work_submit_to_queue(queue, &ctx.work);
+  if (ret < 0) {
+    return ret;
+  }
+  k_work_flush(&ctx.work, &sync);
+
+  return ctx.ret;
+}
+
+#ifdef CONFIG_PAW3222_STATS
+static int paw32xx_stats_reset_on_queue(const struct device *dev, void *arg) {
+  struct paw32xx_data *data = dev->data;
+
+  ARG_UNUSED(arg);
+
+  /* The ISR may have a submission in flight: keep submit_cyc/_pending */
+  memset(&data->stats, 0, offsetof(struct paw32xx_stats, submit_cyc));
+#ifdef CONFIG_PAW3222_PIPELINE
+  paw32xx_pipeline_reset(dev);
+#endif
+  return 0;
+}
+
+int paw32xx_stats_reset(const struct device *dev) {
+  return paw32xx_queue_call(dev, paw32xx_stats_reset_on_queue, NULL);
+}
+#endif
+
+static int paw32xx_reinit_on_queue(const struct device *dev, void *arg) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  int ret;
+
+  ARG_UNUSED(arg);
+
+  /* On the motion work's queue: a queued run is dropped, none is running */
+  gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_DISABLE);
+  k_timer_stop(&data->motion_timer);
+  k_work_cancel(&data->motion_work);
+
+  ret = paw32xx_configure(dev);
+  if (ret < 0) {
+    LOG_ERR("Sensor re-initialization failed: %d", ret);
+  } else {
+    /*
+     * The reset restored the default CPI: re-apply the tuned one here, we
+     * are already next to the motion work (an idle sensor gets it on the
+     * wake). The processing stage may be busy with an earlier sample, so
+     * it drops the scroll accumulators itself before the next one.
+     */
+    data->current_cpi = -1;
+    atomic_set(&data->core_reset, 1);
+    if (!data->idle_sm.idle) {
+      paw32xx_switch_cpi(dev, data->input_mode);
     }
-  
-//LOG_INF("end of get_input_mode_for_current_layer/ PAW32XX_MOVE"); // XYSCROLL_DEBUG_LOG
-  return PAW32XX_MOVE;
+  }
+
+  gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+  return ret;
 }
 
+int paw32xx_reinit(const struct device *dev) {
+  return paw32xx_queue_call(dev, paw32xx_reinit_on_queue, NULL);
+}
 
-/**
- * @brief Calculate scroll Y coordinate based on sensor rotation
- *
- * Transforms the raw sensor coordinates to ensure that Y-axis movement
- * always triggers scrolling regardless of the physical sensor orientation.
- * This allows the sensor to be mounted at different angles while maintaining
- * consistent scroll behavior.
- *
- * @param x Raw X coordinate from sensor
- * @param y Raw Y coordinate from sensor  
- * @param rotation Physical sensor rotation in degrees (0, 90, 180, 270)
- * 
- * @return Transformed Y coordinate for scroll calculations
- * 
- * @note For cursor movement, use ZMK input-processors like zip_xy_transform
- *       instead of this function. This is specifically for scroll modes.
- * 
- * @note Handles INT16_MIN overflow case to prevent undefined behavior
- *       when negating the minimum signed integer value.
- */
-static int16_t calculate_scroll_y(int16_t x, int16_t y, uint16_t rotation) {
-  switch (rotation) {
-  case 0:
-    return y;
-  case 90:
-    return x;
-  case 180:
-    return (y == INT16_MIN) ? INT16_MAX : -y;
-  case 270:
-    return (x == INT16_MIN) ? INT16_MAX : -x;
-  default:
-    return y;
+/* Sensor sleep request; the weak default in paw3222_power.c only logs */
+static void paw32xx_idle_set_sleep(const struct device *dev, bool sleep) {
+#if CONFIG_PAW3222_POWER_CTRL
+  int ret = paw3222_set_sleep(dev, sleep);
+
+  if (ret < 0) {
+    LOG_WRN("PAW32XX: paw3222_set_sleep(%d) failed: %d", sleep, ret);
+  }
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(sleep);
+#endif
+}
+
+void paw32xx_idle_event(const struct device *dev, enum paw32xx_idle_event ev) {
+  struct paw32xx_data *data = dev->data;
+  const struct paw32xx_config *cfg = dev->config;
+  bool probe = data->idle_sm.probe;
+  uint16_t act;
+  uint32_t cyc;
+
+  /*
+   * A sample clears the expiry and re-arms the idle timer below. Stop the
+   * timer first: an expiry between the two would mark the fresh sample's
+   * timeout expired and put the sensor to sleep right after it.
+   */
+  if (ev == PAW32XX_IDLE_EV_SAMPLE) {
+    k_timer_stop(&data->idle_timer);
+  }
+  act = paw32xx_idle_step(&data->idle_sm, ev);
+
+  if (act & PAW32XX_IDLE_ACT_IRQ_OFF) {
+    gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_DISABLE);
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_STOP) {
+    k_timer_stop(&data->motion_timer);
+  }
+  if ((act & (PAW32XX_IDLE_ACT_WAKE | PAW32XX_IDLE_ACT_SLEEP)) &&
+      (probe || data->idle_sm.probe)) {
+    /* Fallback probe of a faulted line: not an idle transition */
+    paw32xx_idle_set_sleep(dev, (act & PAW32XX_IDLE_ACT_SLEEP) != 0);
+    act &= ~(PAW32XX_IDLE_ACT_WAKE | PAW32XX_IDLE_ACT_SLEEP);
+  }
+  if (probe && !data->idle_sm.probe && !data->idle_sm.idle) {
+    /* The probe found motion: the idle exit its wake stood for */
+    paw32xx_switch_cpi(dev, data->input_mode);
+    paw32xx_trace_idle(dev, false);
+    PAW32XX_STAT_INC(data, idle_exits);
+    paw32xx_snapshot_request(dev);
+    LOG_INF("PAW32XX: exited idle and resumed normal operation");
+  }
+  if (act & PAW32XX_IDLE_ACT_WAKE) {
+    cyc = paw32xx_cycles_begin();
+    paw32xx_idle_set_sleep(dev, false);
+    /* A mode or profile change while asleep left its CPI to the wake */
+    paw32xx_switch_cpi(dev, data->input_mode);
+    paw32xx_trace_idle(dev, false);
+    PAW32XX_STAT_INC(data, idle_exits);
+    paw32xx_cycles_end(dev, PAW32XX_CYCLES_IDLE_EXIT, cyc);
+    paw32xx_snapshot_request(dev);
+    LOG_INF("PAW32XX: exited idle and resumed normal operation");
+  }
+  if (act & PAW32XX_IDLE_ACT_SLEEP) {
+    cyc = paw32xx_cycles_begin();
+    paw32xx_idle_set_sleep(dev, true);
+    paw32xx_trace_idle(dev, true);
+    PAW32XX_STAT_INC(data, idle_entries);
+    paw32xx_cycles_end(dev, PAW32XX_CYCLES_IDLE_ENTER, cyc);
+    paw32xx_snapshot_request(dev);
+    LOG_INF("PAW32XX: idle timeout reached, entering idle");
+  }
+  if (act & PAW32XX_IDLE_ACT_IRQ_ON) {
+    gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL) {
+    k_timer_start(&data->motion_timer, K_MSEC(data->tune.poll_ms), K_NO_WAIT);
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_REDUCED) {
+    k_timer_start(&data->motion_timer, K_MSEC(data->tune.reduced_scan_ms),
+                  K_NO_WAIT);
+  }
+  if (act & PAW32XX_IDLE_ACT_ARM_TIMEOUT) {
+    k_timer_start(&data->idle_timer,
+                  K_SECONDS(data->tune.idle_timeout_s), K_NO_WAIT);
+  }
+  if ((act & PAW32XX_IDLE_ACT_RUN) ||
+      ((act & PAW32XX_IDLE_ACT_RECHECK) &&
+       gpio_pin_get_dt(&cfg->irq_gpio) > 0)) {
+    paw32xx_submit_motion_work(data);
+  }
+  if (act & PAW32XX_IDLE_ACT_TIMEOUT_WORK) {
+    /* The sleep request talks to the sensor; leave interrupt context */
+    paw32xx_pipeline_submit(&data->idle_work);
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_FALLBACK) {
+    k_timer_start(&data->motion_timer,
+                  K_MSEC(data->idle_sm.idle
+                             ? CONFIG_PAW3222_LINE_FALLBACK_IDLE_MS
+                             : CONFIG_PAW3222_LINE_FALLBACK_MS),
+                  K_NO_WAIT);
   }
 }
 
 void paw32xx_motion_timer_handler(struct k_timer *timer) {
   struct paw32xx_data *data =
       CONTAINER_OF(timer, struct paw32xx_data, motion_timer);
-  k_work_submit(&data->motion_work);
+
+  PAW32XX_TRACING_ENTER(timer, 0);
+  paw32xx_idle_event(data->dev, PAW32XX_IDLE_EV_POLL);
+  PAW32XX_TRACING_EXIT(timer, 0);
 }
 
 void paw32xx_motion_work_handler(struct k_work *work) {
@@ -287,129 +639,127 @@ void paw32xx_motion_work_handler(struct k_work *work) {
   int16_t x, y;
   int ret;
   bool irq_disabled = true;
+  bool line_only = false;
+#ifndef CONFIG_PAW3222_PIPELINE
+  /* With the pipeline the per-sample cost is the processing stage's */
+  uint32_t cyc = paw32xx_cycles_begin();
+#endif
+
+  PAW32XX_STAT_INC(data, work_runs);
+  paw32xx_line_run(dev);
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_RUN);
+#ifdef CONFIG_PAW3222_STATS
+  if (data->stats.submit_pending) {
+    uint32_t delay_us =
+        k_cyc_to_us_floor32(k_cycle_get_32() - data->stats.submit_cyc);
+
+    data->stats.submit_pending = false;
+    data->stats.work_delay_max_us = MAX(data->stats.work_delay_max_us, delay_us);
+  }
+#endif
 
+  PAW32XX_TRACING_ENTER(spi, PAW32XX_MOTION);
   ret = paw32xx_read_reg(dev, PAW32XX_MOTION, &val);
+  PAW32XX_TRACING_EXIT(spi, ret);
   if (ret < 0) {
     LOG_ERR("Motion register read failed: %d", ret);
+    PAW32XX_STAT_INC(data, spi_errors);
     goto cleanup;
   }
 
   if ((val & MOTION_STATUS_MOTION) == 0x00) {
-    gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+    /* Motion stopped: hand any batched samples to sensor API consumers */
+    paw32xx_sensor_flush(dev);
+    paw32xx_pipeline_flush(dev);
+    if (data->idle_sm.fault) {
+      /* No edge to wait for: keep polling until the line can be trusted */
+      paw32xx_line_fault_quiet(dev);
+      return;
+    }
+    paw32xx_idle_event(dev, PAW32XX_IDLE_EV_QUIET);
     irq_disabled = false;
     if (gpio_pin_get_dt(&cfg->irq_gpio) == 0) {
+      paw32xx_line_quiet(dev);
       return;
     }
+    /* Motion may have arrived since, or the line is stuck asserted */
+    line_only = true;
   }
 
+  PAW32XX_TRACING_ENTER(spi, PAW32XX_DELTA_X);
   ret = paw32xx_read_xy(dev, &x, &y);
+  PAW32XX_TRACING_EXIT(spi, ret);
   if (ret < 0) {
     LOG_ERR("XY data read failed: %d", ret);
+    PAW32XX_STAT_INC(data, spi_errors);
     goto cleanup;
   }
 
-  /* reset idle timer on any motion activity */
-  if (!data->idle_timer_inited) {
-    k_timer_init(&data->idle_timer, paw32xx_idle_timeout_handler, NULL);
-    data->idle_timer_inited = true;
-  }
-  /* if we were idle, wake up first */
-  if (data->idle) {
-    LOG_INF("PAW32XX: motion detected while idle -> waking up");
-    paw32xx_idle_exit(dev);
+  if (line_only && x == 0 && y == 0 && paw32xx_line_phantom(dev)) {
+    return;
   }
-  /* start/restart the idle timer (per-device) */
-  k_timer_start(&data->idle_timer, K_SECONDS(CONFIG_PAW3222_IDLE_TIMEOUT_SECONDS), K_NO_WAIT);
-
-  // For scroll modes, we need to transform coordinates based on rotation
-  // to ensure y-axis movement always triggers scroll regardless of sensor
-  // orientation
-  int16_t scroll_y = calculate_scroll_y(x, y, cfg->rotation);
+  paw32xx_line_sample(dev);
 
-  // Debug log
-  LOG_DBG("x=%d y=%d scroll_y=%d rotation=%d", x, y, scroll_y, cfg->rotation);
+  paw32xx_latency_mark_spi(dev);
+  PAW32XX_STAT_INC(data, samples);
+  paw32xx_recorder_sample(dev, val, x, y, data->input_mode);
+  paw32xx_sensor_push(dev, x, y);
 
-  enum paw32xx_input_mode input_mode = get_input_mode_for_current_layer(dev);
+  /* Resolved on mode and layer changes, never per sample */
+  enum paw32xx_input_mode input_mode = data->input_mode;
 
   // CPI Switching
-  int16_t target_cpi = cfg->res_cpi;
-  if (input_mode == PAW32XX_SNIPE) {
-    // Use snipe_cpi if configured, otherwise use default from Kconfig
-    target_cpi =
-        (cfg->snipe_cpi > 0) ? cfg->snipe_cpi : CONFIG_PAW3222_SNIPE_CPI;
-  }
-  if (data->current_cpi != target_cpi) {
-    ret = paw32xx_set_resolution(dev, target_cpi);
-    if (ret == 0) {
-      data->current_cpi = target_cpi;
-    } else {
-      LOG_WRN("Failed to set CPI to %d: %d", target_cpi, ret);
-    }
-  }
-  
-
-  /* XYSCROLL_DEBUG_LOG */
-  LOG_INF("input_mode=%d", input_mode); // XYSCROLL_DEBUG_LOG
-
-  switch (input_mode) {
-  case PAW32XX_MOVE: { // Normal cursor movement
-    input_report_rel(data->dev, INPUT_REL_X, x, false, K_NO_WAIT);
-    input_report_rel(data->dev, INPUT_REL_Y, y, true, K_FOREVER);
-    break;
-  }
-  case PAW32XX_SNIPE: { // High-precision cursor movement
-    uint8_t divisor = MAX(1, cfg->snipe_divisor);
-    int16_t snipe_x = x / divisor;
-    int16_t snipe_y = y / divisor;
-    input_report_rel(data->dev, INPUT_REL_X, snipe_x, false, K_NO_WAIT);
-    input_report_rel(data->dev, INPUT_REL_Y, snipe_y, true, K_FOREVER);
-    break;
-  }
-  case PAW32XX_SCROLL: // Vertical scroll
-    process_scroll_input(data->dev, &data->scroll_accumulator, scroll_y, cfg->scroll_tick, false);
-    break;
-  case PAW32XX_SCROLL_HORIZONTAL: // Horizontal scroll
-    process_scroll_input(data->dev, &data->scroll_accumulator, scroll_y, cfg->scroll_tick, true);
-    break;
-  case PAW32XX_SCROLL_SNIPE: // High-precision vertical scroll
-    {
-      uint8_t divisor = MAX(1, cfg->scroll_snipe_divisor);
-      int16_t snipe_scroll_y = scroll_y / divisor;
-      process_scroll_input(data->dev, &data->scroll_accumulator, snipe_scroll_y, cfg->scroll_snipe_tick, false);
-    }
-    break;
-  case PAW32XX_SCROLL_HORIZONTAL_SNIPE: // High-precision horizontal scroll
-    {
-      uint8_t divisor = MAX(1, cfg->scroll_snipe_divisor);
-      int16_t snipe_scroll_y = scroll_y / divisor;
-      process_scroll_input(data->dev, &data->scroll_accumulator, snipe_scroll_y, cfg->scroll_snipe_tick, true);
-    }
-    break;
-  case PAW32XX_BOTHSCROLL: // XY同時スクロール
-    {
-      // X軸スクロール値の算出（必要に応じて座標変換）
-      int16_t scroll_x = calculate_scroll_y(y, x, cfg->rotation); // X/Y入れ替えでX軸用
-      process_scroll_input(data->dev, &data->scroll_accumulator_x, scroll_x, cfg->scroll_tick, true);
-      process_scroll_input(data->dev, &data->scroll_accumulator_y, scroll_y, cfg->scroll_tick, false);
+  paw32xx_switch_cpi(dev, input_mode);
 
-    }
-    break;
-  default:
-    LOG_ERR("Unknown input_mode: %d", input_mode);
-    break;
-  }
+  paw32xx_trace_sample(dev, x, y, input_mode);
+
+#ifdef CONFIG_PAW3222_PIPELINE
+  /* Processing runs at lower priority; a slow report does not stall reads */
+  paw32xx_pipeline_push(dev, x, y, input_mode);
+#else
+  paw32xx_process_sample(dev, x, y, input_mode, cyc);
+#endif
 
-  /* Restart motion timer with normal 15ms scan frequency for active operation.
-   * Reduced scan frequency is only used during idle state. */
-  k_timer_start(&data->motion_timer, K_MSEC(15), K_NO_WAIT);
+  /* Restart the idle timeout and keep polling while motion continues */
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_SAMPLE);
   return;
 
 cleanup:
-  if (irq_disabled) {
+  if (data->idle_sm.fault) {
+    /* No edge will come: keep the fallback poll going */
+    paw32xx_idle_event(dev, PAW32XX_IDLE_EV_QUIET);
+  } else if (irq_disabled) {
     gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_EDGE_TO_ACTIVE);
   }
 }
 
+void paw32xx_process_sample(const struct device *dev, int16_t x, int16_t y,
+                            enum paw32xx_input_mode input_mode, uint32_t cyc) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_core_out out;
+  int ret;
+
+  /* Only this stage touches the accumulators; see paw32xx_apply_mode() */
+  if (atomic_clear(&data->core_reset)) {
+    paw32xx_core_reset(&data->core);
+  }
+
+  PAW32XX_TRACING_ENTER(xform, data->tune.core.rotation);
+  ret = paw32xx_core_process(&data->tune.core, &data->core, input_mode, x, y,
+                             &out);
+  PAW32XX_TRACING_EXIT(xform, out.count);
+  if (ret < 0) {
+    LOG_ERR("Unknown input_mode: %d", input_mode);
+  } else if (out.clamped) {
+    LOG_WRN("Scroll accumulator clamped");
+  }
+
+  PAW32XX_TRACING_ENTER(report, input_mode);
+  paw32xx_report_sample(dev, &out);
+  PAW32XX_TRACING_EXIT(report, input_mode);
+  paw32xx_cycles_end(dev, PAW32XX_CYCLES_SAMPLE_BASE + input_mode, cyc);
+}
+
 void paw32xx_motion_handler(const struct device *gpio_dev,
                             struct gpio_callback *cb, uint32_t pins) {
   ARG_UNUSED(gpio_dev);
@@ -418,106 +768,23 @@ void paw32xx_motion_handler(const struct device *gpio_dev,
   const struct device *dev = data->dev;
   const struct paw32xx_config *cfg = dev->config;
 
-  gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_DISABLE);
-  k_timer_stop(&data->motion_timer);
-  /* If idle, wake up sensor and resume processing */
-  if (data->idle) {
-    LOG_INF("PAW32XX: IRQ while idle -> waking up");
-    paw32xx_idle_exit(dev);
-    /* After waking up, still process the motion that triggered the IRQ */
-    k_work_submit(&data->motion_work);
-    return;
-  }
-  k_work_submit(&data->motion_work);
+  PAW32XX_TRACING_ENTER(irq, cfg->irq_gpio.pin);
+  paw32xx_latency_mark_irq(dev);
+  paw32xx_line_edge(dev);
+  PAW32XX_STAT_INC(data, irqs);
+  /* A wake from idle happens when the motion work runs */
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_IRQ);
+  PAW32XX_TRACING_EXIT(irq, data->idle_sm.idle);
 }
 
 void paw32xx_idle_timeout_handler(struct k_timer *timer) {
   struct paw32xx_data *data = CONTAINER_OF(timer, struct paw32xx_data, idle_timer);
-  const struct device *dev = data->dev;
-  const struct paw32xx_config *cfg = dev->config;
-
-  LOG_INF("PAW32XX: idle timeout reached, entering idle");
-
-  /* cancel motion processing but keep IRQ enabled for wake-up */
-  k_work_cancel(&data->motion_work);
-  k_timer_stop(&data->motion_timer);
 
-  /* attempt to put sensor to low-power if available */
-#ifdef CONFIG_PAW3222_POWER_CTRL
-#if defined(CONFIG_PAW3222_POWER_CTRL)
-  int rc_sleep = paw3222_set_sleep(dev, true);
-  if (rc_sleep) {
-    LOG_WRN("PAW32XX: paw3222_set_sleep(true) failed: %d", rc_sleep);
-  } else {
-    LOG_INF("PAW32XX: sensor set to sleep");
-  }
-#else
-  (void)paw3222_set_sleep(dev, true);
-#endif
-#endif
-
-  data->idle = true;
+  paw32xx_idle_event(data->dev, PAW32XX_IDLE_EV_EXPIRE);
 }
 
-void paw32xx_idle_enter(const struct device *dev) {
-  /* Enter idle state: ensure motion processing is stopped and IRQ disabled.
-   * Most work (timer/work cancel) is handled by caller, but provide a
-   * defensive wrapper so platforms calling this directly get consistent
-   * behavior.
-   */
-  if (dev) {
-    const struct paw32xx_config *cfg = dev->config;
-    struct paw32xx_data *data = dev->data;
+void paw32xx_idle_work_handler(struct k_work *work) {
+  struct paw32xx_data *data = CONTAINER_OF(work, struct paw32xx_data, idle_work);
 
-    /* disable irq and stop motion processing to be safe */
-    gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_DISABLE);
-    k_work_cancel(&data->motion_work);
-    k_timer_stop(&data->motion_timer);
-    if (!data->idle_timer_inited) {
-      k_timer_init(&data->idle_timer, paw32xx_idle_timeout_handler, NULL);
-      data->idle_timer_inited = true;
-    }
-    data->idle = true;
-  }
-}
-
-void paw32xx_idle_exit(const struct device *dev) {
-  struct paw32xx_data *data = dev->data;
-  const struct paw32xx_config *cfg = dev->config;
-  int rc;
-
-  if (!data->idle) {
-    return;
-  }
-
-#ifdef CONFIG_PAW3222_POWER_CTRL
-  {
-    int rc = paw3222_set_sleep(dev, false);
-    if (rc) {
-      LOG_WRN("PAW32XX: paw3222_set_sleep(false) failed: %d", rc);
-    } else {
-      LOG_INF("PAW32XX: sensor wake request succeeded");
-    }
-  }
-#endif
-
-  /* re-enable irq */
-  gpio_pin_interrupt_configure_dt(&cfg->irq_gpio, GPIO_INT_EDGE_TO_ACTIVE);
-
-  /* restart motion processing */
-  /* restart motion processing */
-#if defined(CONFIG_PAW3222_REDUCED_SCAN) && CONFIG_PAW3222_REDUCED_SCAN
-  k_timer_start(&data->motion_timer, K_MSEC(CONFIG_PAW3222_REDUCED_SCAN_MS), K_NO_WAIT);
-#else
-  k_timer_start(&data->motion_timer, K_MSEC(15), K_NO_WAIT);
-#endif
-  k_work_submit(&data->motion_work);
-  data->idle = false;
-  /* restart idle timer (per-device) */
-  if (!data->idle_timer_inited) {
-    k_timer_init(&data->idle_timer, paw32xx_idle_timeout_handler, NULL);
-    data->idle_timer_inited = true;
-  }
-  k_timer_start(&data->idle_timer, K_SECONDS(CONFIG_PAW3222_IDLE_TIMEOUT_SECONDS), K_NO_WAIT);
-  LOG_INF("PAW32XX: exited idle and resumed normal operation");
+  paw32xx_idle_event(data->dev, PAW32XX_IDLE_EV_TIMEOUT);
 }
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_latency.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+static inline uint8_t paw32xx_latency_bucket(uint32_t us) {
+  /* 0 us -> bucket 0, [2^(i-1), 2^i) us -> bucket i */
+  uint8_t bucket = (us == 0) ? 0 : (uint8_t)(32 - __builtin_clz(us));
+
+  return MIN(bucket, PAW32XX_LATENCY_BUCKETS - 1);
+}
+
+void paw32xx_latency_record(const struct device *dev,
+                            enum paw32xx_latency_stage stage, uint32_t cycles) {
+  struct paw32xx_data *data = dev->data;
+  uint32_t us = k_cyc_to_us_floor32(cycles);
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->latency.lock);
+  data->latency.hist[stage][paw32xx_latency_bucket(us)]++;
+  if (us > data->latency.max_us[stage]) {
+    data->latency.max_us[stage] = us;
+  }
+  k_spin_unlock(&data->latency.lock, key);
+}
+
+int paw32xx_latency_get(const struct device *dev,
+                        enum paw32xx_latency_stage stage,
+                        uint32_t buckets[PAW32XX_LATENCY_BUCKETS],
+                        uint32_t *max_us) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  if ((unsigned int)stage >= PAW32XX_LATENCY_STAGE_COUNT) {
+    return -EINVAL;
+  }
+
+  key = k_spin_lock(&data->latency.lock);
+  memcpy(buckets, data->latency.hist[stage],
+         sizeof(data->latency.hist[stage]));
+  if (max_us != NULL) {
+    *max_us = data->latency.max_us[stage];
+  }
+  k_spin_unlock(&data->latency.lock, key);
+
+  return 0;
+}
+
+void paw32xx_latency_reset(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->latency.lock);
+  memset(data->latency.hist, 0, sizeof(data->latency.hist));
+  memset(data->latency.max_us, 0, sizeof(data->latency.max_us));
+  k_spin_unlock(&data->latency.lock, key);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_idle.h"
+#include "paw3222_input.h"
+#include "paw3222_line.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define PAW32XX_LINE_WINDOW_MS 1000
+
+static void paw32xx_line_fault(const struct device *dev, bool stuck) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_line *line = &data->line;
+  int ret;
+
+  line->fault_ms = k_uptime_get_32();
+  line->phantom_runs = 0;
+  line->spurious = 0;
+  if (stuck) {
+    line->stuck_faults++;
+  } else {
+    line->storm_faults++;
+  }
+
+  LOG_WRN("Motion line %s: resetting the sensor, polling every %d ms",
+          stuck ? "stuck asserted" : "toggling without motion",
+          CONFIG_PAW3222_LINE_FALLBACK_MS);
+
+  /* Clears a latched motion output; faults are at most one per retry */
+  line->resets++;
+  ret = paw32xx_reinit(dev);
+  if (ret < 0) {
+    line->reset_errors++;
+  }
+
+  /* After the reset: it turns the interrupt back on */
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_FAULT);
+}
+
+void paw32xx_line_init(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  memset(&data->line, 0, sizeof(data->line));
+}
+
+void paw32xx_line_run(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_line *line = &data->line;
+
+  line->edge_run = atomic_clear(&line->edge) != 0;
+  if (data->idle_sm.fault) {
+    line->fallback_runs++;
+  }
+}
+
+void paw32xx_line_quiet(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_line *line = &data->line;
+  uint32_t now;
+
+  line->phantom_runs = 0;
+  if (!line->edge_run) {
+    return;
+  }
+
+  /* The interrupt is off from the edge to here: at most one per run */
+  line->spurious_edges++;
+  now = k_uptime_get_32();
+  if (now - line->window_ms >= PAW32XX_LINE_WINDOW_MS) {
+    line->window_ms = now;
+    line->spurious = 0;
+  }
+  if (++line->spurious >= CONFIG_PAW3222_LINE_SPURIOUS_PER_S) {
+    paw32xx_line_fault(dev, false);
+  }
+}
+
+bool paw32xx_line_phantom(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_line *line = &data->line;
+
+  line->phantoms++;
+  if (++line->phantom_runs >= CONFIG_PAW3222_LINE_STUCK_RUNS) {
+    paw32xx_line_fault(dev, true);
+  } else {
+    paw32xx_idle_event(dev, PAW32XX_IDLE_EV_PHANTOM);
+  }
+
+  return true;
+}
+
+void paw32xx_line_sample(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  data->line.phantom_runs = 0;
+}
+
+void paw32xx_line_fault_quiet(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_line *line = &data->line;
+
+  if (gpio_pin_get_dt(&cfg->irq_gpio) == 0 &&
+      k_uptime_get_32() - line->fault_ms >=
+          CONFIG_PAW3222_LINE_RETRY_S * MSEC_PER_SEC) {
+    line->recoveries++;
+    LOG_INF("Motion line released, back to interrupts");
+    paw32xx_idle_event(dev, PAW32XX_IDLE_EV_CLEAR);
+    return;
+  }
+
+  paw32xx_idle_event(dev, PAW32XX_IDLE_EV_QUIET);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_params.h"
+#include "paw3222_pipeline.h"
+#include "paw3222_regs.h"
+
+#define PAW32XX_PARAM(_id, _name, _field, _min, _max)                          \
+  [_id] = {                                                                    \
+      .name = _name,                                                           \
+      .offset = offsetof(struct paw32xx_tuning, _field),                       \
+      .size = sizeof(((struct paw32xx_tuning *)0)->_field),                    \
+      .min = _min,                                                             \
+      .max = _max,                                                             \
+  }
+
+static const struct paw32xx_param paw32xx_params[] = {
+    PAW32XX_PARAM(PAW32XX_PARAM_CPI, "cpi", res_cpi, RES_MIN, RES_MAX),
+    PAW32XX_PARAM(PAW32XX_PARAM_SNIPE_CPI, "snipe_cpi", snipe_cpi, RES_MIN,
+                  RES_MAX),
+    PAW32XX_PARAM(PAW32XX_PARAM_SNIPE_DIVISOR, "snipe_divisor",
+                  core.snipe_divisor, 1, 10),
+    PAW32XX_PARAM(PAW32XX_PARAM_SCROLL_SNIPE_DIVISOR, "scroll_snipe_divisor",
+                  core.scroll_snipe_divisor, 1, 10),
+    PAW32XX_PARAM(PAW32XX_PARAM_SCROLL_TICK, "scroll_tick", core.scroll_tick, 1,
+                  255),
+    PAW32XX_PARAM(PAW32XX_PARAM_SCROLL_SNIPE_TICK, "scroll_snipe_tick",
+                  core.scroll_snipe_tick, 1, 255),
+    PAW32XX_PARAM(PAW32XX_PARAM_POLL_MS, "poll_ms", poll_ms, 1, 1000),
+    PAW32XX_PARAM(PAW32XX_PARAM_REDUCED_SCAN_MS, "reduced_scan_ms",
+                  reduced_scan_ms, 1, 10000),
+    PAW32XX_PARAM(PAW32XX_PARAM_IDLE_TIMEOUT_S, "idle_timeout_s",
+                  idle_timeout_s, 1, 86400),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(paw32xx_params) == PAW32XX_PARAM_COUNT,
+             "Parameter table out of sync with enum paw32xx_param_id");
+
+const struct paw32xx_param *paw32xx_param_at(unsigned int id) {
+  if (id >= ARRAY_SIZE(paw32xx_params)) {
+    return NULL;
+  }
+
+  return &paw32xx_params[id];
+}
+
+int paw32xx_param_find(const char *name) {
+  for (size_t i = 0; i < ARRAY_SIZE(paw32xx_params); i++) {
+    if (strcmp(name, paw32xx_params[i].name) == 0) {
+      return i;
+    }
+  }
+
+  return -EINVAL;
+}
+
+int paw32xx_param_get(const struct device *dev, unsigned int id,
+                      int32_t *value) {
+  const struct paw32xx_param *p = paw32xx_param_at(id);
+  struct paw32xx_data *data = dev->data;
+  const uint8_t *field;
+
+  if (p == NULL) {
+    return -EINVAL;
+  }
+
+  field = (const uint8_t *)&data->tune + p->offset;
+
+  /* Signed fields never hold negative values once validated */
+  switch (p->size) {
+  case sizeof(uint8_t):
+    *value = *field;
+    break;
+  case sizeof(uint16_t):
+    *value = *(const uint16_t *)field;
+    break;
+  case sizeof(uint32_t):
+    *value = *(const uint32_t *)field;
+    break;
+  default:
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+int paw32xx_param_set(const struct device *dev, unsigned int id,
+                      int32_t value) {
+  const struct paw32xx_param *p = paw32xx_param_at(id);
+  struct paw32xx_data *data = dev->data;
+  uint8_t *field;
+
+  if (p == NULL || value < p->min || value > p->max) {
+    return -EINVAL;
+  }
+
+  field = (uint8_t *)&data->tune + p->offset;
+
+  /* Single aligned stores: the motion path sees the old or the new value */
+  switch (p->size) {
+  case sizeof(uint8_t):
+    *field = (uint8_t)value;
+    break;
+  case sizeof(uint16_t):
+    *(uint16_t *)field = (uint16_t)value;
+    break;
+  case sizeof(uint32_t):
+    *(uint32_t *)field = (uint32_t)value;
+    break;
+  default:
+    return -EINVAL;
+  }
+
+  /* CPI is written next to the motion work instead of from the caller */
+  paw32xx_pipeline_submit(&data->tune_work);
+  return 0;
+}
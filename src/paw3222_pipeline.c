@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_cycles.h"
+#include "paw3222_input.h"
+#include "paw3222_pipeline.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_PAW3222_PIPELINE_DEPTH),
+             "CONFIG_PAW3222_PIPELINE_DEPTH must be a power of two");
+
+#define PAW32XX_PIPE_MASK (CONFIG_PAW3222_PIPELINE_DEPTH - 1)
+
+/* Shared by all instances: one thread reads every sensor */
+static struct k_work_q paw32xx_acq_q;
+static K_KERNEL_STACK_DEFINE(paw32xx_acq_stack,
+                             CONFIG_PAW3222_PIPELINE_STACK_SIZE);
+static bool paw32xx_acq_started;
+
+static void paw32xx_pipeline_work_handler(struct k_work *work) {
+  struct paw32xx_pipe *pipe = CONTAINER_OF(work, struct paw32xx_pipe, work);
+  struct paw32xx_data *data = CONTAINER_OF(pipe, struct paw32xx_data, pipe);
+  uint32_t tail = atomic_get(&pipe->tail);
+  uint32_t head = atomic_get(&pipe->head);
+
+  /* Samples pushed meanwhile resubmit this work; no need to loop on head */
+  while (tail != head) {
+    const struct paw32xx_pipe_sample *s = &pipe->ring[tail & PAW32XX_PIPE_MASK];
+    uint32_t wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - s->cycles);
+
+    pipe->wait_max_us = MAX(pipe->wait_max_us, wait_us);
+    paw32xx_process_sample(data->dev, s->x, s->y,
+                           (enum paw32xx_input_mode)s->input_mode,
+                           paw32xx_cycles_begin());
+    /* Releases the slot to the producer */
+    atomic_set(&pipe->tail, ++tail);
+  }
+}
+
+void paw32xx_pipeline_init(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_pipe *pipe = &data->pipe;
+
+  /* Device init runs single-threaded: no race on the first start */
+  if (!paw32xx_acq_started) {
+    const struct k_work_queue_config qcfg = {.name = "paw32xx_acq"};
+
+    k_work_queue_init(&paw32xx_acq_q);
+    k_work_queue_start(&paw32xx_acq_q, paw32xx_acq_stack,
+                       K_KERNEL_STACK_SIZEOF(paw32xx_acq_stack),
+                       CONFIG_PAW3222_PIPELINE_PRIORITY, &qcfg);
+    paw32xx_acq_started = true;
+  }
+
+  atomic_set(&pipe->head, 0);
+  atomic_set(&pipe->tail, 0);
+  pipe->carry_x = 0;
+  pipe->carry_y = 0;
+  pipe->overruns = 0;
+  pipe->depth_max = 0;
+  pipe->wait_max_us = 0;
+  k_work_init(&pipe->work, paw32xx_pipeline_work_handler);
+}
+
+struct k_work_q *paw32xx_pipeline_queue(void) {
+  return &paw32xx_acq_q;
+}
+
+void paw32xx_pipeline_submit(struct k_work *work) {
+  k_work_submit_to_queue(&paw32xx_acq_q, work);
+}
+
+void paw32xx_pipeline_push(const struct device *dev, int16_t x, int16_t y,
+                           enum paw32xx_input_mode input_mode) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_pipe *pipe = &data->pipe;
+  uint32_t head = atomic_get(&pipe->head);
+  uint32_t depth = head - (uint32_t)atomic_get(&pipe->tail);
+  struct paw32xx_pipe_sample *s;
+  /* Symmetric range: rotation negates the deltas */
+  int32_t sx = CLAMP(x + pipe->carry_x, -INT16_MAX, INT16_MAX);
+  int32_t sy = CLAMP(y + pipe->carry_y, -INT16_MAX, INT16_MAX);
+
+  if (depth >= CONFIG_PAW3222_PIPELINE_DEPTH) {
+    pipe->carry_x += x;
+    pipe->carry_y += y;
+    pipe->overruns++;
+    k_work_submit(&pipe->work);
+    return;
+  }
+
+  /* Anything beyond the int16 range stays carried */
+  pipe->carry_x += x - sx;
+  pipe->carry_y += y - sy;
+
+  s = &pipe->ring[head & PAW32XX_PIPE_MASK];
+  s->cycles = k_cycle_get_32();
+  s->x = sx;
+  s->y = sy;
+  s->input_mode = input_mode;
+  /* Publishes the slot to the consumer */
+  atomic_set(&pipe->head, head + 1);
+
+  pipe->depth_max = MAX(pipe->depth_max, depth + 1);
+  k_work_submit(&pipe->work);
+}
+
+void paw32xx_pipeline_flush(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  if (data->pipe.carry_x != 0 || data->pipe.carry_y != 0) {
+    paw32xx_pipeline_push(dev, 0, 0, data->input_mode);
+  }
+}
+
+void paw32xx_pipeline_get(const struct device *dev, uint32_t *overruns,
+                          uint32_t *depth_max, uint32_t *wait_max_us) {
+  const struct paw32xx_data *data = dev->data;
+
+  *overruns = data->pipe.overruns;
+  *depth_max = data->pipe.depth_max;
+  *wait_max_us = data->pipe.wait_max_us;
+}
+
+void paw32xx_pipeline_reset(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  data->pipe.overruns = 0;
+  data->pipe.depth_max = 0;
+  data->pipe.wait_max_us = 0;
+}
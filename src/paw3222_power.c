@@ -104,11 +104,7 @@ int paw32xx_force_awake(const struct device *dev, bool enable) {
     return 0;
 }
 
-int paw32xx_configure(const struct device *dev) {
-    const struct paw32xx_config *cfg = dev->config;
-    uint8_t val;
-    int ret;
-
+static int paw32xx_check_config(const struct paw32xx_config *cfg) {
     // Validate configuration values
     if (cfg->rotation != 0 && cfg->rotation != 90 && 
         cfg->rotation != 180 && cfg->rotation != 270) {
@@ -129,6 +125,19 @@ int paw32xx_configure(const struct device *dev) {
         return -EINVAL;
     }
 
+    return 0;
+}
+
+int paw32xx_configure(const struct device *dev) {
+    const struct paw32xx_config *cfg = dev->config;
+    uint8_t val;
+    int ret;
+
+    ret = paw32xx_check_config(cfg);
+    if (ret < 0) {
+        return ret;
+    }
+
     ret = paw32xx_read_reg(dev, PAW32XX_PRODUCT_ID1, &val);
     if (ret < 0) {
         return ret;
@@ -139,6 +148,9 @@ int paw32xx_configure(const struct device *dev) {
         return -ENOTSUP;
     }
 
+    /* Not adoptable by a warm boot until the configuration is complete */
+    paw32xx_warm_mark(dev, false);
+
     ret = paw32xx_update_reg(dev, PAW32XX_CONFIGURATION, CONFIGURATION_RESET, CONFIGURATION_RESET);
     if (ret < 0) {
         return ret;
@@ -152,8 +164,89 @@ int paw32xx_configure(const struct device *dev) {
 
     paw32xx_force_awake(dev, cfg->force_awake);
 
+    paw32xx_warm_mark(dev, true);
+    return 0;
+}
+
+#ifdef CONFIG_PAW3222_WARM_BOOT
+bool paw32xx_warm_valid(const struct device *dev) {
+    const struct paw32xx_config *cfg = dev->config;
+
+    return cfg->warm->magic == PAW32XX_WARM_MAGIC &&
+           cfg->warm->check == ~PAW32XX_WARM_MAGIC;
+}
+
+void paw32xx_warm_mark(const struct device *dev, bool configured) {
+    const struct paw32xx_config *cfg = dev->config;
+
+    cfg->warm->magic = configured ? PAW32XX_WARM_MAGIC : 0;
+    cfg->warm->check = ~cfg->warm->magic;
+}
+
+int paw32xx_configure_warm(const struct device *dev) {
+    const struct paw32xx_config *cfg = dev->config;
+    struct paw32xx_data *data = dev->data;
+    uint8_t slp = cfg->force_awake ? 0 : OPERATION_MODE_SLP_MASK;
+    uint8_t val, cpi_x, cpi_y;
+    int ret;
+
+    ret = paw32xx_check_config(cfg);
+    if (ret < 0) {
+        return ret;
+    }
+
+    /* Signature: the sensor answers and is neither resetting nor powered down */
+    ret = paw32xx_read_reg(dev, PAW32XX_PRODUCT_ID1, &val);
+    if (ret < 0) {
+        return ret;
+    }
+    if (val != PRODUCT_ID_PAW32XX) {
+        return -ENODEV;
+    }
+
+    ret = paw32xx_read_reg(dev, PAW32XX_CONFIGURATION, &val);
+    if (ret < 0) {
+        return ret;
+    }
+    if (val & (CONFIGURATION_RESET | CONFIGURATION_PD_ENH)) {
+        return -ENODEV;
+    }
+
+    /* Rewrite only what differs from the configuration */
+    if (cfg->res_cpi > 0) {
+        ret = paw32xx_read_reg(dev, PAW32XX_CPI_X, &cpi_x);
+        if (ret < 0) {
+            return ret;
+        }
+        ret = paw32xx_read_reg(dev, PAW32XX_CPI_Y, &cpi_y);
+        if (ret < 0) {
+            return ret;
+        }
+        if (cpi_x != cfg->res_cpi / RES_STEP || cpi_y != cfg->res_cpi / RES_STEP) {
+            ret = paw32xx_set_resolution(dev, cfg->res_cpi);
+            if (ret < 0) {
+                return ret;
+            }
+        }
+        /* Already in the register: the first sample need not write it */
+        data->current_cpi = cfg->res_cpi;
+    }
+
+    ret = paw32xx_read_reg(dev, PAW32XX_OPERATION_MODE, &val);
+    if (ret < 0) {
+        return ret;
+    }
+    if ((val & OPERATION_MODE_SLP_MASK) != slp) {
+        ret = paw32xx_force_awake(dev, cfg->force_awake);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    paw32xx_warm_mark(dev, true);
     return 0;
 }
+#endif
 
 #ifdef CONFIG_PM_DEVICE
 int paw32xx_pm_action(const struct device *dev, enum pm_device_action action) {
@@ -165,6 +258,8 @@ int paw32xx_pm_action(const struct device *dev, enum pm_device_action action) {
 
     switch (action) {
     case PM_DEVICE_ACTION_SUSPEND:
+        /* Powered down or off: a reboot from here needs the full init */
+        paw32xx_warm_mark(dev, false);
         val = CONFIGURATION_PD_ENH;
         ret = paw32xx_update_reg(dev, PAW32XX_CONFIGURATION, CONFIGURATION_PD_ENH, val);
         if (ret < 0) {
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_recfmt.h"
+#include "paw3222_recorder.h"
+#include "paw3222_regs.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define PAW32XX_REC_BLOCKS CONFIG_PAW3222_RECORDER_BLOCKS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PAW32XX_REC_BLOCKS),
+             "CONFIG_PAW3222_RECORDER_BLOCKS must be a power of two");
+BUILD_ASSERT(sizeof(struct paw32xx_rec_ring_hdr) == PAW32XX_REC_RING_HDR_SIZE);
+BUILD_ASSERT(sizeof(struct paw32xx_rec_block_hdr) ==
+             PAW32XX_REC_BLOCK_HDR_SIZE);
+BUILD_ASSERT(PAW32XX_BOTHSCROLL_SNIPE <= PAW32XX_REC_FLAG_MODE_MASK);
+
+static void paw32xx_recorder_format(struct paw32xx_rec_ring *ring) {
+  memset(ring, 0, sizeof(*ring));
+  ring->hdr.magic = PAW32XX_REC_MAGIC;
+  ring->hdr.version = PAW32XX_REC_VERSION;
+  ring->hdr.block_size = PAW32XX_REC_BLOCK_SIZE;
+  ring->hdr.block_count = PAW32XX_REC_BLOCKS;
+}
+
+/* Called with the recorder lock held */
+static void paw32xx_recorder_open_block(struct paw32xx_recorder *rec,
+                                        struct paw32xx_rec_ring *ring,
+                                        uint32_t t_us) {
+  uint16_t seq = ring->hdr.next_seq++;
+  struct paw32xx_rec_block_hdr bhdr = {
+      .t0_us = t_us,
+      .seq = seq,
+      .boot = ring->hdr.boot,
+      .used = 0,
+  };
+
+  rec->block = ring->blocks[seq & (PAW32XX_REC_BLOCKS - 1)];
+  memcpy(rec->block, &bhdr, sizeof(bhdr));
+  memset(&rec->prev, 0, sizeof(rec->prev));
+  rec->prev.t_us = t_us;
+}
+
+void paw32xx_recorder_init(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_rec_ring *ring = cfg->rec_ring;
+  struct paw32xx_rec_ring_hdr hdr;
+
+  data->recorder.block = NULL;
+
+  if (paw32xx_rec_parse_hdr((const uint8_t *)ring, sizeof(*ring), &hdr) == 0 &&
+      hdr.block_count == PAW32XX_REC_BLOCKS) {
+    ring->hdr.boot++;
+    LOG_INF("Kept motion recording, boot %u", ring->hdr.boot);
+    return;
+  }
+
+  paw32xx_recorder_format(ring);
+}
+
+void paw32xx_recorder_sample(const struct device *dev, uint8_t status,
+                             int16_t x, int16_t y, uint8_t input_mode) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_recorder *rec = &data->recorder;
+  struct paw32xx_rec_block_hdr bhdr;
+  uint8_t buf[PAW32XX_REC_SAMPLE_MAX];
+  struct paw32xx_rec_sample s = {
+      .t_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks()),
+      .x = x,
+      .y = y,
+      .flags = input_mode & PAW32XX_REC_FLAG_MODE_MASK,
+  };
+  k_spinlock_key_t key;
+  uint8_t len;
+
+  if (status & MOTION_STATUS_MOTION) {
+    s.flags |= PAW32XX_REC_FLAG_MOT;
+  }
+  if (status & MOTION_STATUS_DXOVF) {
+    s.flags |= PAW32XX_REC_FLAG_DXOVF;
+  }
+  if (status & MOTION_STATUS_DYOVF) {
+    s.flags |= PAW32XX_REC_FLAG_DYOVF;
+  }
+
+  key = k_spin_lock(&rec->lock);
+
+  if (rec->block == NULL) {
+    paw32xx_recorder_open_block(rec, cfg->rec_ring, s.t_us);
+  }
+
+  memcpy(&bhdr, rec->block, sizeof(bhdr));
+  len = paw32xx_rec_encode(buf, &rec->prev, &s);
+  if (bhdr.used + len > PAW32XX_REC_PAYLOAD_SIZE) {
+    /* Blocks are self-contained: re-encode against the new block start */
+    paw32xx_recorder_open_block(rec, cfg->rec_ring, s.t_us);
+    memcpy(&bhdr, rec->block, sizeof(bhdr));
+    len = paw32xx_rec_encode(buf, &rec->prev, &s);
+  }
+
+  memcpy(&rec->block[PAW32XX_REC_BLOCK_HDR_SIZE + bhdr.used], buf, len);
+  bhdr.used += len;
+  memcpy(rec->block, &bhdr, sizeof(bhdr));
+  rec->prev = s;
+
+  k_spin_unlock(&rec->lock, key);
+}
+
+size_t paw32xx_recorder_read(const struct device *dev, size_t offset,
+                             uint8_t *buf, size_t len) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  if (offset >= sizeof(*cfg->rec_ring)) {
+    return 0;
+  }
+
+  len = MIN(len, sizeof(*cfg->rec_ring) - offset);
+
+  key = k_spin_lock(&data->recorder.lock);
+  memcpy(buf, (const uint8_t *)cfg->rec_ring + offset, len);
+  k_spin_unlock(&data->recorder.lock, key);
+
+  return len;
+}
+
+size_t paw32xx_recorder_size(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+
+  return sizeof(*cfg->rec_ring);
+}
+
+void paw32xx_recorder_clear(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->recorder.lock);
+  paw32xx_recorder_format(cfg->rec_ring);
+  data->recorder.block = NULL;
+  k_spin_unlock(&data->recorder.lock, key);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_input.h"
+#include "paw3222_params.h"
+#include "paw3222_pipeline.h"
+#include "paw3222_rpc.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+/* Response under construction; overflow is sticky and checked once */
+struct paw32xx_rpc_buf {
+  uint8_t *data;
+  size_t size;
+  size_t len;
+  bool overflow;
+};
+
+static uint8_t *paw32xx_rpc_reserve(struct paw32xx_rpc_buf *buf, size_t n) {
+  uint8_t *p;
+
+  if (buf->overflow || buf->size - buf->len < n) {
+    buf->overflow = true;
+    return NULL;
+  }
+
+  p = &buf->data[buf->len];
+  buf->len += n;
+  return p;
+}
+
+static void paw32xx_rpc_put_u8(struct paw32xx_rpc_buf *buf, uint8_t val) {
+  uint8_t *p = paw32xx_rpc_reserve(buf, sizeof(val));
+
+  if (p != NULL) {
+    *p = val;
+  }
+}
+
+static void paw32xx_rpc_put_le16(struct paw32xx_rpc_buf *buf, uint16_t val) {
+  uint8_t *p = paw32xx_rpc_reserve(buf, sizeof(val));
+
+  if (p != NULL) {
+    sys_put_le16(val, p);
+  }
+}
+
+static void paw32xx_rpc_put_le32(struct paw32xx_rpc_buf *buf, uint32_t val) {
+  uint8_t *p = paw32xx_rpc_reserve(buf, sizeof(val));
+
+  if (p != NULL) {
+    sys_put_le32(val, p);
+  }
+}
+
+static int paw32xx_rpc_param(const struct device *dev, uint8_t op,
+                             const uint8_t *args, size_t len,
+                             struct paw32xx_rpc_buf *buf) {
+  const struct paw32xx_param *p;
+  int32_t value;
+  int ret;
+
+  if (len < 1) {
+    return -EINVAL;
+  }
+
+  p = paw32xx_param_at(args[0]);
+  if (p == NULL) {
+    return -EINVAL;
+  }
+
+  if (op == PAW32XX_RPC_PARAM_DESC) {
+    paw32xx_rpc_put_u8(buf, args[0]);
+    paw32xx_rpc_put_u8(buf, p->size);
+    paw32xx_rpc_put_le32(buf, p->min);
+    paw32xx_rpc_put_le32(buf, p->max);
+    for (const char *c = p->name; *c != '\0'; c++) {
+      paw32xx_rpc_put_u8(buf, *c);
+    }
+    return 0;
+  }
+
+  if (op == PAW32XX_RPC_SET) {
+    if (len < 1 + sizeof(uint32_t)) {
+      return -EINVAL;
+    }
+    ret = paw32xx_param_set(dev, args[0], (int32_t)sys_get_le32(&args[1]));
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  /* SET answers with the value now in effect, like GET */
+  paw32xx_param_get(dev, args[0], &value);
+  paw32xx_rpc_put_u8(buf, args[0]);
+  paw32xx_rpc_put_le32(buf, value);
+  return 0;
+}
+
+static void paw32xx_rpc_stats(const struct device *dev,
+                              struct paw32xx_rpc_buf *buf) {
+#ifdef CONFIG_PAW3222_STATS
+  const struct paw32xx_data *data = dev->data;
+  uint32_t overruns = 0, depth_max = 0, wait_max_us = 0;
+  uint32_t line_stuck = 0, line_storms = 0, line_fallback = 0;
+
+#ifdef CONFIG_PAW3222_PIPELINE
+  paw32xx_pipeline_get(dev, &overruns, &depth_max, &wait_max_us);
+#endif
+#ifdef CONFIG_PAW3222_LINE_MONITOR
+  line_stuck = data->line.stuck_faults;
+  line_storms = data->line.storm_faults;
+  line_fallback = data->line.fallback_runs;
+#endif
+
+  const uint32_t counters[] = {
+      [PAW32XX_RPC_STAT_IRQS] = data->stats.irqs,
+      [PAW32XX_RPC_STAT_WORK_RUNS] = data->stats.work_runs,
+      [PAW32XX_RPC_STAT_SAMPLES] = data->stats.samples,
+      [PAW32XX_RPC_STAT_REPORTS] = data->stats.reports,
+      [PAW32XX_RPC_STAT_SPI_ERRORS] = data->stats.spi_errors,
+      [PAW32XX_RPC_STAT_CPI_WRITES] = data->stats.cpi_writes,
+      [PAW32XX_RPC_STAT_IDLE_ENTRIES] = data->stats.idle_entries,
+      [PAW32XX_RPC_STAT_IDLE_EXITS] = data->stats.idle_exits,
+      [PAW32XX_RPC_STAT_MODE_CHANGES] = data->stats.mode_changes,
+      [PAW32XX_RPC_STAT_WORK_DELAY_MAX_US] = data->stats.work_delay_max_us,
+      [PAW32XX_RPC_STAT_REPORT_BLOCK_MAX_US] = data->stats.report_block_max_us,
+      [PAW32XX_RPC_STAT_REPORT_STALLS] = data->stats.report_stalls,
+      [PAW32XX_RPC_STAT_RING_OVERRUNS] = overruns,
+      [PAW32XX_RPC_STAT_RING_WAIT_MAX_US] = wait_max_us,
+      [PAW32XX_RPC_STAT_LINE_STUCK] = line_stuck,
+      [PAW32XX_RPC_STAT_LINE_STORMS] = line_storms,
+      [PAW32XX_RPC_STAT_LINE_FALLBACK_RUNS] = line_fallback,
+  };
+
+  BUILD_ASSERT(ARRAY_SIZE(counters) == PAW32XX_RPC_STAT_COUNT);
+  /* Opcode, status, count and the counters */
+  BUILD_ASSERT(3 + 4 * PAW32XX_RPC_STAT_COUNT <= PAW32XX_RPC_MAX_RESP,
+               "PAW32XX_RPC_MAX_RESP too small for a STATS reply");
+
+  paw32xx_rpc_put_u8(buf, ARRAY_SIZE(counters));
+  for (size_t i = 0; i < ARRAY_SIZE(counters); i++) {
+    paw32xx_rpc_put_le32(buf, counters[i]);
+  }
+#else
+  ARG_UNUSED(dev);
+  paw32xx_rpc_put_u8(buf, 0);
+#endif
+}
+
+static int paw32xx_rpc_dispatch(const struct device *dev, uint8_t op,
+                                const uint8_t *args, size_t len,
+                                struct paw32xx_rpc_buf *buf) {
+  struct paw32xx_data *data = dev->data;
+
+  switch (op) {
+  case PAW32XX_RPC_INFO:
+    paw32xx_rpc_put_u8(buf, PAW32XX_RPC_VERSION);
+    paw32xx_rpc_put_u8(buf, PAW32XX_PARAM_COUNT);
+    paw32xx_rpc_put_u8(buf, IS_ENABLED(CONFIG_PAW3222_STATS)
+                                ? PAW32XX_RPC_STAT_COUNT
+                                : 0);
+    return 0;
+  case PAW32XX_RPC_PARAM_DESC:
+  case PAW32XX_RPC_GET:
+  case PAW32XX_RPC_SET:
+    return paw32xx_rpc_param(dev, op, args, len, buf);
+  case PAW32XX_RPC_STATS:
+    paw32xx_rpc_stats(dev, buf);
+    return 0;
+  case PAW32XX_RPC_STATE:
+    paw32xx_rpc_put_u8(buf, data->idle_sm.idle);
+    paw32xx_rpc_put_u8(buf, data->input_mode);
+    paw32xx_rpc_put_u8(buf, data->profile);
+    paw32xx_rpc_put_le16(buf, (uint16_t)data->current_cpi);
+    paw32xx_rpc_put_u8(buf, data->idle_sm.fault);
+    return 0;
+  case PAW32XX_RPC_STATS_RESET:
+#ifdef CONFIG_PAW3222_STATS
+    return paw32xx_stats_reset(dev);
+#else
+    return -ENOTSUP;
+#endif
+  default:
+    return -ENOTSUP;
+  }
+}
+
+int paw32xx_rpc_handle(const struct device *dev, const uint8_t *req,
+                       size_t req_len, uint8_t *resp, size_t resp_size) {
+  struct paw32xx_rpc_buf buf = {.data = resp, .size = resp_size};
+  int status;
+
+  if (req_len < 1) {
+    return -EINVAL;
+  }
+
+  paw32xx_rpc_put_u8(&buf, req[0] | PAW32XX_RPC_RESP);
+  paw32xx_rpc_put_u8(&buf, 0);
+  if (buf.overflow) {
+    return -ENOBUFS;
+  }
+
+  status = paw32xx_rpc_dispatch(dev, req[0], &req[1], req_len - 1, &buf);
+  if (buf.overflow) {
+    return -ENOBUFS;
+  }
+
+  if (status < 0) {
+    LOG_DBG("RPC op 0x%02x failed: %d", req[0], status);
+    resp[1] = (uint8_t)(int8_t)status;
+    return 2;
+  }
+
+  return buf.len;
+}
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_sensor.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define DT_DRV_COMPAT pixart_paw3222
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+
+/* Raw deltas are at most 16 bits wide, so a Q31 shift of 15 is lossless */
+#define PAW32XX_SENSOR_Q31_SHIFT 15
+
+/* Scale of a raw delta in the Q31 result; a multiply, negative deltas too */
+#define PAW32XX_SENSOR_Q31_SCALE (1 << (31 - PAW32XX_SENSOR_Q31_SHIFT))
+
+#define PAW32XX_SENSOR_MIN_BUF_LEN                                             \
+  (sizeof(struct paw32xx_sensor_encoded) + sizeof(struct paw32xx_sensor_sample))
+#define PAW32XX_SENSOR_IDEAL_BUF_LEN                                           \
+  (sizeof(struct paw32xx_sensor_encoded) +                                     \
+   PAW32XX_SENSOR_BATCH_MAX * sizeof(struct paw32xx_sensor_sample))
+
+static inline uint64_t paw32xx_sensor_now_ns(void) {
+  return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+static bool paw32xx_sensor_chan_supported(enum sensor_channel chan) {
+  switch (chan) {
+  case SENSOR_CHAN_POS_DX:
+  case SENSOR_CHAN_POS_DY:
+  case SENSOR_CHAN_ALL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool paw32xx_sensor_trigger_supported(enum sensor_trigger_type trigger) {
+  return trigger == SENSOR_TRIG_DATA_READY || trigger == SENSOR_TRIG_MOTION;
+}
+
+/**
+ * @brief Take the pending streaming request out of the sensor state
+ *
+ * Must be called with the sensor lock held. The caller completes the
+ * returned request after releasing the lock.
+ */
+static struct rtio_iodev_sqe *
+paw32xx_sensor_take_stream(struct paw32xx_sensor_state *state) {
+  struct rtio_iodev_sqe *sqe = state->stream_sqe;
+
+  state->stream_sqe = NULL;
+  state->stream_buf = NULL;
+  state->stream_buf_len = 0;
+  return sqe;
+}
+
+/**
+ * @brief Forget a pending streaming request its owner has cancelled
+ *
+ * RTIO only flags a cancelled request; it must not be completed anymore.
+ * Must be called with the sensor lock held.
+ */
+static void paw32xx_sensor_drop_canceled(struct paw32xx_sensor_state *state) {
+  if (state->stream_sqe != NULL &&
+      (state->stream_sqe->sqe.flags & RTIO_SQE_CANCELED) != 0) {
+    paw32xx_sensor_take_stream(state);
+  }
+}
+
+static void paw32xx_sensor_submit_one_shot(const struct device *dev,
+                                           struct rtio_iodev_sqe *iodev_sqe) {
+  const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_sensor_encoded *edata;
+  uint8_t *buf;
+  uint32_t buf_len;
+  k_spinlock_key_t key;
+  int ret;
+
+  for (size_t i = 0; i < read_cfg->count; i++) {
+    if (!paw32xx_sensor_chan_supported(read_cfg->channels[i].chan_type)) {
+      LOG_ERR("Unsupported sensor channel: %d", read_cfg->channels[i].chan_type);
+      rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+      return;
+    }
+  }
+
+  ret = rtio_sqe_rx_buf(iodev_sqe, PAW32XX_SENSOR_MIN_BUF_LEN,
+                        PAW32XX_SENSOR_MIN_BUF_LEN, &buf, &buf_len);
+  if (ret < 0) {
+    LOG_ERR("Failed to get sensor read buffer: %d", ret);
+    rtio_iodev_sqe_err(iodev_sqe, ret);
+    return;
+  }
+
+  /* One-shot reads report the latest sample seen by the motion handler
+   * rather than reading the sensor, since reading clears the delta
+   * registers and would steal motion from the input path. The sample is
+   * consumed, so a read with no motion since the previous one returns
+   * zero deltas instead of the same motion again.
+   */
+  edata = (struct paw32xx_sensor_encoded *)buf;
+  memset(edata, 0, PAW32XX_SENSOR_MIN_BUF_LEN);
+
+  key = k_spin_lock(&data->sensor.lock);
+  if (data->sensor.fresh) {
+    edata->base_timestamp_ns = data->sensor.last_timestamp_ns;
+    edata->samples[0].x = data->sensor.last_x;
+    edata->samples[0].y = data->sensor.last_y;
+    data->sensor.fresh = false;
+  } else {
+    edata->base_timestamp_ns = paw32xx_sensor_now_ns();
+  }
+  k_spin_unlock(&data->sensor.lock, key);
+
+  edata->count = 1;
+  rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+static void paw32xx_sensor_submit_stream(const struct device *dev,
+                                         struct rtio_iodev_sqe *iodev_sqe) {
+  const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_sensor_encoded *edata;
+  uint8_t *buf;
+  uint32_t buf_len;
+  k_spinlock_key_t key;
+  int ret;
+
+  for (size_t i = 0; i < read_cfg->count; i++) {
+    if (!paw32xx_sensor_trigger_supported(read_cfg->triggers[i].trigger)) {
+      LOG_ERR("Unsupported stream trigger: %d", read_cfg->triggers[i].trigger);
+      rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+      return;
+    }
+  }
+
+  ret = rtio_sqe_rx_buf(iodev_sqe, PAW32XX_SENSOR_MIN_BUF_LEN,
+                        PAW32XX_SENSOR_IDEAL_BUF_LEN, &buf, &buf_len);
+  if (ret < 0) {
+    LOG_ERR("Failed to get sensor stream buffer: %d", ret);
+    rtio_iodev_sqe_err(iodev_sqe, ret);
+    return;
+  }
+
+  edata = (struct paw32xx_sensor_encoded *)buf;
+  memset(edata, 0, sizeof(*edata));
+  edata->data_ready = 1;
+
+  key = k_spin_lock(&data->sensor.lock);
+  paw32xx_sensor_drop_canceled(&data->sensor);
+  if (data->sensor.stream_sqe != NULL) {
+    k_spin_unlock(&data->sensor.lock, key);
+    LOG_ERR("Sensor stream already active");
+    rtio_iodev_sqe_err(iodev_sqe, -EBUSY);
+    return;
+  }
+  data->sensor.stream_sqe = iodev_sqe;
+  data->sensor.stream_buf = buf;
+  data->sensor.stream_buf_len = buf_len;
+  k_spin_unlock(&data->sensor.lock, key);
+}
+
+static void paw32xx_sensor_submit(const struct device *dev,
+                                  struct rtio_iodev_sqe *iodev_sqe) {
+  const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+
+  if (read_cfg->is_streaming) {
+    paw32xx_sensor_submit_stream(dev, iodev_sqe);
+  } else {
+    paw32xx_sensor_submit_one_shot(dev, iodev_sqe);
+  }
+}
+
+void paw32xx_sensor_push(const struct device *dev, int16_t x, int16_t y) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_sensor_state *state = &data->sensor;
+  struct rtio_iodev_sqe *done = NULL;
+  uint64_t now = paw32xx_sensor_now_ns();
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&state->lock);
+  state->last_timestamp_ns = now;
+  state->last_x = x;
+  state->last_y = y;
+  state->fresh = true;
+
+  paw32xx_sensor_drop_canceled(state);
+  if (state->stream_sqe != NULL) {
+    struct paw32xx_sensor_encoded *edata =
+        (struct paw32xx_sensor_encoded *)state->stream_buf;
+    struct paw32xx_sensor_sample *sample = &edata->samples[edata->count];
+
+    if (edata->count == 0) {
+      edata->base_timestamp_ns = now;
+    }
+    sample->timestamp_delta = (uint32_t)(now - edata->base_timestamp_ns);
+    sample->x = x;
+    sample->y = y;
+    edata->count++;
+
+    /* Complete the request once there is no room for another sample */
+    if (sizeof(*edata) + (edata->count + 1) * sizeof(*sample) >
+        state->stream_buf_len) {
+      done = paw32xx_sensor_take_stream(state);
+    }
+  }
+  k_spin_unlock(&state->lock, key);
+
+  if (done != NULL) {
+    rtio_iodev_sqe_ok(done, 0);
+  }
+}
+
+void paw32xx_sensor_flush(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_sensor_state *state = &data->sensor;
+  struct rtio_iodev_sqe *done = NULL;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&state->lock);
+  paw32xx_sensor_drop_canceled(state);
+  if (state->stream_sqe != NULL &&
+      ((struct paw32xx_sensor_encoded *)state->stream_buf)->count > 0) {
+    done = paw32xx_sensor_take_stream(state);
+  }
+  k_spin_unlock(&state->lock, key);
+
+  if (done != NULL) {
+    rtio_iodev_sqe_ok(done, 0);
+  }
+}
+
+static int paw32xx_sensor_sample_fetch(const struct device *dev,
+                                       enum sensor_channel chan) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_sensor_state *state = &data->sensor;
+  k_spinlock_key_t key;
+
+  if (!paw32xx_sensor_chan_supported(chan)) {
+    return -ENOTSUP;
+  }
+
+  /* Samples are captured by the motion handler; latch the unread one, or
+   * zero deltas when there was no motion since the previous read
+   */
+  key = k_spin_lock(&state->lock);
+  state->fetched_x = state->fresh ? state->last_x : 0;
+  state->fetched_y = state->fresh ? state->last_y : 0;
+  state->fresh = false;
+  k_spin_unlock(&state->lock, key);
+
+  return 0;
+}
+
+static int paw32xx_sensor_channel_get(const struct device *dev,
+                                      enum sensor_channel chan,
+                                      struct sensor_value *val) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+  int ret = 0;
+
+  key = k_spin_lock(&data->sensor.lock);
+  switch (chan) {
+  case SENSOR_CHAN_POS_DX:
+    val->val1 = data->sensor.fetched_x;
+    val->val2 = 0;
+    break;
+  case SENSOR_CHAN_POS_DY:
+    val->val1 = data->sensor.fetched_y;
+    val->val2 = 0;
+    break;
+  default:
+    ret = -ENOTSUP;
+    break;
+  }
+  k_spin_unlock(&data->sensor.lock, key);
+
+  return ret;
+}
+
+static int paw32xx_decoder_get_frame_count(const uint8_t *buffer,
+                                           struct sensor_chan_spec chan_spec,
+                                           uint16_t *frame_count) {
+  const struct paw32xx_sensor_encoded *edata =
+      (const struct paw32xx_sensor_encoded *)buffer;
+
+  if (chan_spec.chan_idx != 0) {
+    return -ENOTSUP;
+  }
+
+  switch (chan_spec.chan_type) {
+  case SENSOR_CHAN_POS_DX:
+  case SENSOR_CHAN_POS_DY:
+    *frame_count = edata->count;
+    return 0;
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static int paw32xx_decoder_get_size_info(struct sensor_chan_spec chan_spec,
+                                         size_t *base_size,
+                                         size_t *frame_size) {
+  switch (chan_spec.chan_type) {
+  case SENSOR_CHAN_POS_DX:
+  case SENSOR_CHAN_POS_DY:
+    *base_size = sizeof(struct sensor_q31_data);
+    *frame_size = sizeof(struct sensor_q31_sample_data);
+    return 0;
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static int paw32xx_decoder_decode(const uint8_t *buffer,
+                                  struct sensor_chan_spec chan_spec,
+                                  uint32_t *fit, uint16_t max_count,
+                                  void *data_out) {
+  const struct paw32xx_sensor_encoded *edata =
+      (const struct paw32xx_sensor_encoded *)buffer;
+  struct sensor_q31_data *out = data_out;
+  uint16_t n = 0;
+
+  if (chan_spec.chan_idx != 0 || (chan_spec.chan_type != SENSOR_CHAN_POS_DX &&
+                                  chan_spec.chan_type != SENSOR_CHAN_POS_DY)) {
+    return -ENOTSUP;
+  }
+
+  if (*fit >= edata->count || max_count == 0) {
+    return 0;
+  }
+
+  out->header.base_timestamp_ns = edata->base_timestamp_ns;
+  out->shift = PAW32XX_SENSOR_Q31_SHIFT;
+
+  while (*fit < edata->count && n < max_count) {
+    const struct paw32xx_sensor_sample *sample = &edata->samples[*fit];
+    int16_t raw =
+        (chan_spec.chan_type == SENSOR_CHAN_POS_DX) ? sample->x : sample->y;
+
+    out->readings[n].timestamp_delta = sample->timestamp_delta;
+    out->readings[n].value = (q31_t)raw * PAW32XX_SENSOR_Q31_SCALE;
+    n++;
+    (*fit)++;
+  }
+  out->header.reading_count = n;
+
+  return n;
+}
+
+static bool paw32xx_decoder_has_trigger(const uint8_t *buffer,
+                                        enum sensor_trigger_type trigger) {
+  const struct paw32xx_sensor_encoded *edata =
+      (const struct paw32xx_sensor_encoded *)buffer;
+
+  return paw32xx_sensor_trigger_supported(trigger) && edata->data_ready;
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+    .get_frame_count = paw32xx_decoder_get_frame_count,
+    .get_size_info = paw32xx_decoder_get_size_info,
+    .decode = paw32xx_decoder_decode,
+    .has_trigger = paw32xx_decoder_has_trigger,
+};
+
+static int paw32xx_sensor_get_decoder(const struct device *dev,
+                                      const struct sensor_decoder_api **decoder) {
+  ARG_UNUSED(dev);
+  *decoder = &SENSOR_DECODER_NAME();
+  return 0;
+}
+
+const struct sensor_driver_api paw32xx_sensor_api = {
+    .sample_fetch = paw32xx_sensor_sample_fetch,
+    .channel_get = paw32xx_sensor_channel_get,
+    .get_decoder = paw32xx_sensor_get_decoder,
+    .submit = paw32xx_sensor_submit,
+};
+
+#endif // DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
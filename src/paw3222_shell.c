@@ -0,0 +1,854 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/printk.h>
+
+#include "paw3222.h"
+#include "paw3222_cycles.h"
+#include "paw3222_emul.h"
+#include "paw3222_input.h"
+#include "paw3222_latency.h"
+#include "paw3222_params.h"
+#include "paw3222_pipeline.h"
+#include "paw3222_power.h"
+#include "paw3222_recorder.h"
+#include "paw3222_regs.h"
+#include "paw3222_rpc.h"
+#include "paw3222_snapshot.h"
+#include "paw3222_spi.h"
+#include "paw3222_trace.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define DT_DRV_COMPAT pixart_paw3222
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+
+#define PAW32XX_DEVICE_ENTRY(n) DEVICE_DT_INST_GET(n),
+
+static const struct device *const paw32xx_devices[] = {
+    DT_INST_FOREACH_STATUS_OKAY(PAW32XX_DEVICE_ENTRY)};
+
+/* Instance the commands operate on, changed with "paw3222 select" */
+static size_t paw32xx_shell_sel;
+
+static const struct {
+  uint8_t addr;
+  const char *name;
+} paw32xx_shell_regs[] = {
+    {PAW32XX_PRODUCT_ID1, "PRODUCT_ID1"},
+    {PAW32XX_PRODUCT_ID2, "PRODUCT_ID2"},
+    {PAW32XX_MOTION, "MOTION"},
+    {PAW32XX_DELTA_X, "DELTA_X"},
+    {PAW32XX_DELTA_Y, "DELTA_Y"},
+    {PAW32XX_OPERATION_MODE, "OPERATION_MODE"},
+    {PAW32XX_CONFIGURATION, "CONFIGURATION"},
+    {PAW32XX_WRITE_PROTECT, "WRITE_PROTECT"},
+    {PAW32XX_SLEEP1, "SLEEP1"},
+    {PAW32XX_SLEEP2, "SLEEP2"},
+    {PAW32XX_SLEEP3, "SLEEP3"},
+    {PAW32XX_CPI_X, "CPI_X"},
+    {PAW32XX_CPI_Y, "CPI_Y"},
+};
+
+static const struct device *paw32xx_shell_dev(const struct shell *sh) {
+  const struct device *dev;
+
+  if (paw32xx_shell_sel >= ARRAY_SIZE(paw32xx_devices)) {
+    shell_error(sh, "No PAW3222 instance selected");
+    return NULL;
+  }
+
+  dev = paw32xx_devices[paw32xx_shell_sel];
+  if (!device_is_ready(dev)) {
+    shell_error(sh, "%s is not ready", dev->name);
+    return NULL;
+  }
+
+  return dev;
+}
+
+static int cmd_paw32xx_select(const struct shell *sh, size_t argc,
+                              char **argv) {
+  unsigned long idx;
+  int err = 0;
+
+  if (argc < 2) {
+    for (size_t i = 0; i < ARRAY_SIZE(paw32xx_devices); i++) {
+      shell_print(sh, "%c %u: %s", i == paw32xx_shell_sel ? '*' : ' ',
+                  (unsigned int)i, paw32xx_devices[i]->name);
+    }
+    return 0;
+  }
+
+  idx = shell_strtoul(argv[1], 0, &err);
+  if (err != 0 || idx >= ARRAY_SIZE(paw32xx_devices)) {
+    shell_error(sh, "Invalid instance: %s", argv[1]);
+    return -EINVAL;
+  }
+
+  paw32xx_shell_sel = idx;
+  return 0;
+}
+
+struct paw32xx_shell_reg_dump {
+  uint8_t vals[ARRAY_SIZE(paw32xx_shell_regs)];
+  size_t done;
+};
+
+static int paw32xx_shell_read_regs(const struct device *dev, void *arg) {
+  struct paw32xx_shell_reg_dump *dump = arg;
+  int ret;
+
+  for (dump->done = 0; dump->done < ARRAY_SIZE(dump->vals); dump->done++) {
+    ret = paw32xx_read_reg(dev, paw32xx_shell_regs[dump->done].addr,
+                           &dump->vals[dump->done]);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+static int cmd_paw32xx_regs(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_shell_reg_dump dump = {.done = 0};
+  int ret;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  /* Read in one go next to the motion work, printed afterwards */
+  ret = paw32xx_queue_call(dev, paw32xx_shell_read_regs, &dump);
+  for (size_t i = 0; i < dump.done; i++) {
+    shell_print(sh, "0x%02x %-15s 0x%02x", paw32xx_shell_regs[i].addr,
+                paw32xx_shell_regs[i].name, dump.vals[i]);
+  }
+  if (ret < 0) {
+    shell_error(sh, "Read of 0x%02x failed: %d",
+                paw32xx_shell_regs[dump.done].addr, ret);
+    return ret;
+  }
+
+  return 0;
+}
+
+static int cmd_paw32xx_state(const struct shell *sh, size_t argc,
+                             char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  const struct paw32xx_data *data;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  data = dev->data;
+
+  shell_print(sh, "base mode:    %s", paw32xx_mode_name(data->current_mode));
+  shell_print(sh, "active mode:  %s",
+              paw32xx_mode_name((enum paw32xx_current_mode)data->input_mode));
+  shell_print(sh, "mode stack:   %u", data->mode_stack_len);
+  for (uint8_t i = data->mode_stack_len; i > 0; i--) {
+    shell_print(sh, "  %s (position %u)",
+                paw32xx_mode_name(data->mode_stack[i - 1].mode),
+                data->mode_stack[i - 1].position);
+  }
+  shell_print(sh, "profile:      %u", data->profile);
+  shell_print(sh, "current cpi:  %d", data->current_cpi);
+  shell_print(sh, "accumulators: %d x=%d y=%d", data->core.scroll_accumulator,
+              data->core.scroll_accumulator_x, data->core.scroll_accumulator_y);
+  shell_print(sh, "idle:         %s", data->idle_sm.idle ? "yes" : "no");
+  shell_print(sh, "boot:         %s, init %u ms",
+              data->warm_boot ? "warm (reset skipped)" : "cold", data->init_ms);
+  shell_print(sh, "motion line:  %s",
+              data->idle_sm.fault ? "faulted, polling" : "ok");
+#ifdef CONFIG_PAW3222_LINE_MONITOR
+  shell_print(sh, "  %u stuck, %u storms, %u resets (%u failed), %u recovered",
+              data->line.stuck_faults, data->line.storm_faults,
+              data->line.resets, data->line.reset_errors,
+              data->line.recoveries);
+  shell_print(sh, "  %u phantom runs, %u spurious edges, %u fallback runs",
+              data->line.phantoms, data->line.spurious_edges,
+              data->line.fallback_runs);
+#endif
+
+  for (unsigned int i = 0; i < PAW32XX_PARAM_COUNT; i++) {
+    int32_t value;
+
+    paw32xx_param_get(dev, i, &value);
+    shell_print(sh, "%-21s %d", paw32xx_param_at(i)->name, value);
+  }
+
+  return 0;
+}
+
+static int cmd_paw32xx_set(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  const struct paw32xx_param *p;
+  long value;
+  int id;
+  int err = 0;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  id = paw32xx_param_find(argv[1]);
+  if (id < 0) {
+    shell_error(sh, "Unknown parameter: %s", argv[1]);
+    return -EINVAL;
+  }
+
+  p = paw32xx_param_at(id);
+  value = shell_strtol(argv[2], 0, &err);
+  if (err != 0 || paw32xx_param_set(dev, id, value) < 0) {
+    shell_error(sh, "%s must be in range %d..%d", p->name, p->min, p->max);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+#ifdef CONFIG_PAW3222_STATS
+static int cmd_paw32xx_stats(const struct shell *sh, size_t argc,
+                             char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_data *data;
+#ifdef CONFIG_PAW3222_PIPELINE
+  uint32_t overruns, depth_max, wait_max_us;
+#endif
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  data = dev->data;
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    return paw32xx_stats_reset(dev);
+  }
+
+  shell_print(sh, "irqs:         %u", data->stats.irqs);
+  shell_print(sh, "work runs:    %u", data->stats.work_runs);
+  shell_print(sh, "samples:      %u", data->stats.samples);
+  shell_print(sh, "reports:      %u", data->stats.reports);
+  shell_print(sh, "spi errors:   %u", data->stats.spi_errors);
+  shell_print(sh, "cpi writes:   %u", data->stats.cpi_writes);
+  shell_print(sh, "idle entries: %u", data->stats.idle_entries);
+  shell_print(sh, "idle exits:   %u", data->stats.idle_exits);
+  shell_print(sh, "mode changes: %u", data->stats.mode_changes);
+  shell_print(sh, "max work delay:   %u us", data->stats.work_delay_max_us);
+  shell_print(sh, "max report block: %u us", data->stats.report_block_max_us);
+  shell_print(sh, "report stalls:    %u", data->stats.report_stalls);
+#ifdef CONFIG_PAW3222_PIPELINE
+  paw32xx_pipeline_get(dev, &overruns, &depth_max, &wait_max_us);
+  shell_print(sh, "ring overruns:    %u", overruns);
+  shell_print(sh, "max ring depth:   %u of %u", depth_max,
+              CONFIG_PAW3222_PIPELINE_DEPTH);
+  shell_print(sh, "max ring wait:    %u us", wait_max_us);
+#endif
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_PAW3222_LATENCY
+static const char *const paw32xx_latency_stage_names[] = {
+    [PAW32XX_LATENCY_IRQ_TO_SPI] = "irq->spi",
+    [PAW32XX_LATENCY_SPI_TO_REPORT] = "spi->report",
+    [PAW32XX_LATENCY_IRQ_TO_REPORT] = "irq->report",
+    [PAW32XX_LATENCY_SPI_TO_HID] = "spi->hid",
+};
+
+/* Work queue hops between the X/Y read and the HID send */
+#define PAW32XX_REPORT_HOPS                                                    \
+  (IS_ENABLED(CONFIG_PAW3222_PIPELINE) +                                       \
+   (!IS_ENABLED(CONFIG_PAW3222_HID_DIRECT) &&                                  \
+    IS_ENABLED(CONFIG_INPUT_MODE_THREAD)))
+
+static int cmd_paw32xx_latency(const struct shell *sh, size_t argc,
+                               char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  uint32_t buckets[PAW32XX_LATENCY_BUCKETS];
+  uint32_t max_us;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    paw32xx_latency_reset(dev);
+    return 0;
+  }
+
+  shell_print(sh, "report path: %s, %d queue hop(s)",
+              IS_ENABLED(CONFIG_PAW3222_HID_DIRECT) ? "direct HID"
+                                                    : "input listener",
+              PAW32XX_REPORT_HOPS);
+  for (int stage = 0; stage < PAW32XX_LATENCY_STAGE_COUNT; stage++) {
+    paw32xx_latency_get(dev, stage, buckets, &max_us);
+    shell_print(sh, "%s (max %u us)", paw32xx_latency_stage_names[stage],
+                max_us);
+    for (int i = 0; i < PAW32XX_LATENCY_BUCKETS; i++) {
+      if (buckets[i] == 0) {
+        continue;
+      }
+      if (i == 0) {
+        shell_print(sh, "  <1 us          %u", buckets[i]);
+      } else if (i == PAW32XX_LATENCY_BUCKETS - 1) {
+        shell_print(sh, "  >=%-6u us     %u", 1U << (i - 1), buckets[i]);
+      } else {
+        shell_print(sh, "  %6u-%-6u us %u", 1U << (i - 1), (1U << i) - 1,
+                    buckets[i]);
+      }
+    }
+  }
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_PAW3222_CYCLE_STATS
+static int cmd_paw32xx_cycles(const struct shell *sh, size_t argc,
+                              char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_cycle_stat stat;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    paw32xx_cycles_reset(dev);
+    return 0;
+  }
+
+  /* CSV so that runs can be captured and diffed against a baseline */
+  shell_print(sh, "op,count,avg_cyc,max_cyc,avg_ns,cyc_hz");
+  for (int op = 0; op < PAW32XX_CYCLES_OP_COUNT; op++) {
+    uint32_t avg;
+
+    paw32xx_cycles_get(dev, op, &stat);
+    avg = stat.count ? (uint32_t)(stat.total_cyc / stat.count) : 0;
+    shell_print(sh, "%s,%u,%u,%u,%u,%u", paw32xx_cycles_op_name(op),
+                stat.count, avg, stat.max_cyc, k_cyc_to_ns_floor32(avg),
+                sys_clock_hw_cycles_per_sec());
+  }
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_PAW3222_TRACE
+static void paw32xx_shell_trace_rec(const struct shell *sh, uint32_t seq,
+                                    uint32_t us,
+                                    const struct paw32xx_trace_rec *rec) {
+  switch (rec->type) {
+  case PAW32XX_TRACE_SAMPLE:
+    shell_print(sh, "%6u %10u sample x=%d y=%d mode=%s", seq, us, rec->a,
+                rec->b, paw32xx_mode_name(rec->arg));
+    break;
+  case PAW32XX_TRACE_MODE:
+    shell_print(sh, "%6u %10u mode %s profile=%d", seq, us,
+                paw32xx_mode_name(rec->arg), rec->a);
+    break;
+  case PAW32XX_TRACE_CPI:
+    shell_print(sh, "%6u %10u cpi %d", seq, us, rec->a);
+    break;
+  case PAW32XX_TRACE_IDLE:
+    shell_print(sh, "%6u %10u idle %s", seq, us, rec->arg ? "enter" : "exit");
+    break;
+  default:
+    shell_print(sh, "%6u %10u type %u", seq, us, rec->type);
+    break;
+  }
+}
+
+static int cmd_paw32xx_trace(const struct shell *sh, size_t argc,
+                             char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_trace_rec rec;
+  uint32_t first, next, base = 0;
+  bool have_base = false;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "clear") != 0) {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    paw32xx_trace_clear(dev);
+    return 0;
+  }
+
+  paw32xx_trace_range(dev, &first, &next);
+  shell_print(sh, "%u records, %u overwritten", next - first, first);
+  shell_print(sh, "   seq    time_us event");
+
+  /* Formatting happens here, one record at a time, not in the hot path */
+  for (uint32_t seq = first; seq != next; seq++) {
+    if (paw32xx_trace_get(dev, seq, &rec) < 0) {
+      continue; /* overwritten while dumping */
+    }
+    if (!have_base) {
+      base = rec.cycles;
+      have_base = true;
+    }
+    paw32xx_shell_trace_rec(sh, seq, k_cyc_to_us_floor32(rec.cycles - base),
+                            &rec);
+  }
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_PAW3222_RECORDER
+/* Hex lines of the raw recording, e.g. for "xxd -r -p" on the host */
+static void paw32xx_shell_record_dump(const struct shell *sh,
+                                      const struct device *dev) {
+  uint8_t buf[32];
+  char line[2 * sizeof(buf) + 1];
+  size_t off = 0, len;
+
+  shell_print(sh, "# paw3222 recording v%u, %u bytes", PAW32XX_REC_VERSION,
+              (unsigned int)paw32xx_recorder_size(dev));
+  while ((len = paw32xx_recorder_read(dev, off, buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++) {
+      snprintk(&line[2 * i], 3, "%02x", buf[i]);
+    }
+    shell_print(sh, "%s", line);
+    off += len;
+  }
+}
+
+static void paw32xx_shell_record_decode(const struct shell *sh,
+                                        const struct device *dev) {
+  uint8_t block[PAW32XX_REC_BLOCK_SIZE];
+  struct paw32xx_rec_ring_hdr hdr;
+  struct paw32xx_rec_block_hdr bhdr;
+  struct paw32xx_rec_cursor cur;
+  struct paw32xx_rec_sample s;
+
+  paw32xx_recorder_read(dev, 0, (uint8_t *)&hdr, sizeof(hdr));
+  shell_print(sh, "boot seq      t_us    x    y mode flags");
+
+  /* Oldest block first: the one the ring will overwrite next */
+  for (uint16_t i = 0; i < hdr.block_count; i++) {
+    uint16_t seq = hdr.next_seq + i;
+    size_t off = PAW32XX_REC_RING_HDR_SIZE +
+                 (size_t)(seq & (hdr.block_count - 1)) * PAW32XX_REC_BLOCK_SIZE;
+    int ret;
+
+    paw32xx_recorder_read(dev, off, block, sizeof(block));
+    if (paw32xx_rec_block_begin(block, &bhdr, &cur) < 0) {
+      continue;
+    }
+    while ((ret = paw32xx_rec_next(&cur, &s)) > 0) {
+      shell_print(sh, "%4u %5u %9u %4d %4d %4u 0x%02x", bhdr.boot, bhdr.seq,
+                  s.t_us, s.x, s.y, s.flags & PAW32XX_REC_FLAG_MODE_MASK,
+                  s.flags & ~PAW32XX_REC_FLAG_MODE_MASK);
+    }
+    if (ret < 0) {
+      shell_warn(sh, "block %u is corrupt", bhdr.seq);
+    }
+  }
+}
+
+static int cmd_paw32xx_record(const struct shell *sh, size_t argc,
+                              char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_rec_ring_hdr hdr;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "dump") == 0) {
+      paw32xx_shell_record_dump(sh, dev);
+    } else if (strcmp(argv[1], "decode") == 0) {
+      paw32xx_shell_record_decode(sh, dev);
+    } else if (strcmp(argv[1], "clear") == 0) {
+      paw32xx_recorder_clear(dev);
+    } else {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    return 0;
+  }
+
+  paw32xx_recorder_read(dev, 0, (uint8_t *)&hdr, sizeof(hdr));
+  shell_print(sh, "format v%u, %u x %u byte blocks, boot %u", hdr.version,
+              hdr.block_count, hdr.block_size, hdr.boot);
+  shell_print(sh, "blocks written: %u", hdr.next_seq);
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_PAW3222_SNAPSHOT
+static int cmd_paw32xx_snapshot(const struct shell *sh, size_t argc,
+                                char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  struct paw32xx_snapshot snap;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "save") != 0) {
+      shell_error(sh, "Unknown argument: %s", argv[1]);
+      return -EINVAL;
+    }
+    paw32xx_snapshot_request(dev);
+    return 0;
+  }
+
+  if (paw32xx_snapshot_prev(dev, &snap) < 0) {
+    shell_print(sh, "No snapshot retained from the previous boot");
+    return 0;
+  }
+
+  shell_print(sh, "boot %u, save %u at %u ms uptime", snap.boot, snap.seq,
+              snap.uptime_ms);
+  shell_print(sh, "state: %s, mode %s, cpi %d",
+              snap.idle ? "idle" : "active",
+              paw32xx_mode_name((enum paw32xx_current_mode)snap.input_mode),
+              snap.cpi);
+#ifdef CONFIG_PAW3222_STATS
+  shell_print(sh, "irqs %u, work runs %u, samples %u, reports %u",
+              snap.stats.irqs, snap.stats.work_runs, snap.stats.samples,
+              snap.stats.reports);
+  shell_print(sh, "spi errors %u, idle entries %u, idle exits %u",
+              snap.stats.spi_errors, snap.stats.idle_entries,
+              snap.stats.idle_exits);
+  shell_print(sh, "max work delay %u us, max report block %u us, stalls %u",
+              snap.stats.work_delay_max_us, snap.stats.report_block_max_us,
+              snap.stats.report_stalls);
+#endif
+#ifdef CONFIG_PAW3222_LATENCY
+  for (int i = 0; i < PAW32XX_LATENCY_STAGE_COUNT; i++) {
+    shell_print(sh, "max %s: %u us", paw32xx_latency_stage_names[i],
+                snap.latency_max_us[i]);
+  }
+#endif
+#ifdef CONFIG_PAW3222_TRACE
+  shell_print(sh, "last %u trace records (time relative to the newest):",
+              snap.trace_count);
+  for (uint8_t i = 0; i < snap.trace_count; i++) {
+    uint32_t newest = snap.trace[snap.trace_count - 1].cycles;
+
+    paw32xx_shell_trace_rec(sh, snap.trace_seq + i,
+                            k_cyc_to_us_floor32(newest - snap.trace[i].cycles),
+                            &snap.trace[i]);
+  }
+#endif
+
+  return 0;
+}
+#endif
+
+#if defined(CONFIG_PAW3222_EMUL) && defined(CONFIG_PAW3222_STATS)
+/* Motion added per frame during a storm; saturates the 8-bit deltas */
+#define PAW32XX_STORM_DELTA 300
+#define PAW32XX_STORM_IRQ_PERIOD_US 200
+#define PAW32XX_STORM_MODE_PERIOD_MS 1
+
+/*
+ * Cycles the behavior-selected mode while a storm runs. With
+ * switch-method = layer the keymap owns the mode and the shell cannot move
+ * it, so the storm runs without mode changes and says so.
+ */
+static struct {
+  struct k_work_delayable work;
+  const struct device *dev;
+  bool active;
+  uint32_t switches;
+} paw32xx_storm_modes;
+
+/* Runs on the queue of the motion work, between two motion reads */
+static int paw32xx_storm_mode_next(const struct device *dev, void *arg) {
+  enum paw32xx_current_mode mode = paw32xx_mode_effective(dev);
+
+  ARG_UNUSED(arg);
+
+  paw32xx_mode_set_effective(dev, (mode + 1) % PAW32XX_MODE_COUNT);
+  paw32xx_update_effective_mode(dev);
+  paw32xx_apply_mode(dev);
+  return 0;
+}
+
+static int paw32xx_storm_mode_restore(const struct device *dev, void *arg) {
+  paw32xx_mode_set_effective(dev, *(enum paw32xx_current_mode *)arg);
+  paw32xx_update_effective_mode(dev);
+  paw32xx_apply_mode(dev);
+  return 0;
+}
+
+static void paw32xx_storm_mode_handler(struct k_work *work) {
+  ARG_UNUSED(work);
+
+  if (!paw32xx_storm_modes.active) {
+    return;
+  }
+
+  if (paw32xx_queue_call(paw32xx_storm_modes.dev, paw32xx_storm_mode_next,
+                         NULL) == 0) {
+    paw32xx_storm_modes.switches++;
+  }
+
+  k_work_schedule(&paw32xx_storm_modes.work,
+                  K_MSEC(PAW32XX_STORM_MODE_PERIOD_MS));
+}
+
+static int cmd_paw32xx_storm(const struct shell *sh, size_t argc,
+                             char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  const struct paw32xx_config *cfg;
+  const struct emul *emul;
+  struct paw32xx_emul_storm storm = {
+      .dx = PAW32XX_STORM_DELTA,
+      .dy = -PAW32XX_STORM_DELTA,
+      .irq_period_us = PAW32XX_STORM_IRQ_PERIOD_US,
+  };
+  struct paw32xx_emul_stats before, after;
+  struct paw32xx_data *data;
+  enum paw32xx_current_mode saved_mode;
+  struct k_work_sync sync;
+  uint32_t edges;
+#ifdef CONFIG_PAW3222_PIPELINE
+  uint32_t overruns, depth_max, wait_max_us;
+#endif
+  long ms;
+  int ret;
+  char *end;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  ms = strtol(argv[1], &end, 0);
+  if (*end != '\0' || ms < 1 || ms > 60000) {
+    shell_error(sh, "Duration must be 1..60000 ms");
+    return -EINVAL;
+  }
+  if (argc > 2) {
+    long period = strtol(argv[2], &end, 0);
+
+    if (*end != '\0' || period < 0 || period > 1000000) {
+      shell_error(sh, "IRQ period must be 0..1000000 us");
+      return -EINVAL;
+    }
+    storm.irq_period_us = (uint32_t)period;
+  }
+
+  emul = emul_get_binding(dev->name);
+  if (emul == NULL) {
+    shell_error(sh, "%s has no emulator", dev->name);
+    return -ENODEV;
+  }
+
+  cfg = dev->config;
+  data = dev->data;
+  saved_mode = paw32xx_mode_effective(dev);
+  ret = paw32xx_stats_reset(dev);
+  if (ret < 0) {
+    shell_error(sh, "Failed to reset the counters: %d", ret);
+    return ret;
+  }
+  paw32xx_emul_get_stats(emul, &before);
+
+  if (paw32xx_storm_modes.dev == NULL) {
+    k_work_init_delayable(&paw32xx_storm_modes.work,
+                          paw32xx_storm_mode_handler);
+  }
+  paw32xx_storm_modes.dev = dev;
+  paw32xx_storm_modes.switches = 0;
+  paw32xx_storm_modes.active = cfg->switch_method != PAW32XX_SWITCH_LAYER;
+
+  paw32xx_emul_storm_start(emul, &storm);
+  if (paw32xx_storm_modes.active) {
+    k_work_schedule(&paw32xx_storm_modes.work, K_NO_WAIT);
+  }
+
+  k_msleep(ms);
+
+  /* A flip already past its active check finishes before the restore */
+  paw32xx_storm_modes.active = false;
+  k_work_cancel_delayable_sync(&paw32xx_storm_modes.work, &sync);
+  paw32xx_emul_storm_stop(emul);
+  paw32xx_emul_get_stats(emul, &after);
+
+  /* Leave the device in the mode it was in before the storm */
+  paw32xx_queue_call(dev, paw32xx_storm_mode_restore, &saved_mode);
+
+  edges = after.irq_edges - before.irq_edges;
+  shell_print(sh, "storm %ld ms, pulse every %u us, %d/%d per frame", ms,
+              storm.irq_period_us, storm.dx, storm.dy);
+  shell_print(sh, "emulator: %u edges (%u forced), %u counts saturated",
+              edges, after.storm_pulses - before.storm_pulses,
+              after.saturations - before.saturations);
+  shell_print(sh, "driver:   %u irqs, %u work runs, %u samples, %u reports",
+              data->stats.irqs, data->stats.work_runs, data->stats.samples,
+              data->stats.reports);
+  shell_print(sh, "missed edges:     %d",
+              (int)(edges - MIN(edges, data->stats.irqs)));
+  shell_print(sh, "max work delay:   %u us", data->stats.work_delay_max_us);
+  shell_print(sh, "max report block: %u us, %u stalls",
+              data->stats.report_block_max_us, data->stats.report_stalls);
+  if (cfg->switch_method == PAW32XX_SWITCH_LAYER) {
+    shell_print(sh, "mode switches:    none, the layer selects the mode");
+  } else {
+    shell_print(sh, "mode switches:    %u requested, %u effective",
+                paw32xx_storm_modes.switches, data->stats.mode_changes);
+  }
+  shell_print(sh, "spi errors:       %u", data->stats.spi_errors);
+#ifdef CONFIG_PAW3222_PIPELINE
+  paw32xx_pipeline_get(dev, &overruns, &depth_max, &wait_max_us);
+  shell_print(sh, "ring:             %u overruns, max depth %u, max wait %u us",
+              overruns, depth_max, wait_max_us);
+#endif
+
+  return 0;
+}
+#endif
+
+static int cmd_paw32xx_reinit(const struct shell *sh, size_t argc,
+                              char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  int ret;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  ret = paw32xx_reinit(dev);
+  if (ret < 0) {
+    shell_error(sh, "Re-initialization failed: %d", ret);
+    return ret;
+  }
+
+  shell_print(sh, "%s re-initialized", dev->name);
+  return 0;
+}
+
+#ifdef CONFIG_PAW3222_RPC
+static int cmd_paw32xx_rpc(const struct shell *sh, size_t argc, char **argv) {
+  const struct device *dev = paw32xx_shell_dev(sh);
+  uint8_t req[16];
+  uint8_t resp[PAW32XX_RPC_MAX_RESP];
+  char hex[2 * PAW32XX_RPC_MAX_RESP + 1];
+  size_t req_len;
+  int len;
+
+  if (dev == NULL) {
+    return -ENODEV;
+  }
+
+  req_len = hex2bin(argv[1], strlen(argv[1]), req, sizeof(req));
+  if (req_len == 0) {
+    shell_error(sh, "Invalid request: %s", argv[1]);
+    return -EINVAL;
+  }
+
+  len = paw32xx_rpc_handle(dev, req, req_len, resp, sizeof(resp));
+  if (len < 0) {
+    shell_error(sh, "Request failed: %d", len);
+    return len;
+  }
+
+  bin2hex(resp, len, hex, sizeof(hex));
+  shell_print(sh, "%s", hex);
+  return 0;
+}
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_paw32xx,
+    SHELL_CMD_ARG(select, NULL, "List instances or select one: [index]",
+                  cmd_paw32xx_select, 1, 1),
+    SHELL_CMD(regs, NULL,
+              "Dump all sensor registers (consumes pending motion)",
+              cmd_paw32xx_regs),
+    SHELL_CMD(state, NULL, "Show mode, CPI, accumulators and tunables",
+              cmd_paw32xx_state),
+    SHELL_CMD_ARG(set, NULL,
+                  "Set a tunable: <cpi|snipe_cpi|snipe_divisor|"
+                  "scroll_snipe_divisor|scroll_tick|scroll_snipe_tick|"
+                  "poll_ms|reduced_scan_ms|idle_timeout_s> <value>",
+                  cmd_paw32xx_set, 3, 0),
+#ifdef CONFIG_PAW3222_STATS
+    SHELL_CMD_ARG(stats, NULL, "Show performance counters: [reset]",
+                  cmd_paw32xx_stats, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_LATENCY
+    SHELL_CMD_ARG(latency, NULL, "Show latency histograms: [reset]",
+                  cmd_paw32xx_latency, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_CYCLE_STATS
+    SHELL_CMD_ARG(cycles, NULL, "Show per-operation cycle cost as CSV: [reset]",
+                  cmd_paw32xx_cycles, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_TRACE
+    SHELL_CMD_ARG(trace, NULL, "Dump the trace ring buffer: [clear]",
+                  cmd_paw32xx_trace, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_RECORDER
+    SHELL_CMD_ARG(record, NULL,
+                  "Show the motion recording: [dump|decode|clear]",
+                  cmd_paw32xx_record, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_SNAPSHOT
+    SHELL_CMD_ARG(snapshot, NULL,
+                  "Show the previous boot's retained snapshot: [save]",
+                  cmd_paw32xx_snapshot, 1, 1),
+#endif
+#ifdef CONFIG_PAW3222_RPC
+    SHELL_CMD_ARG(rpc, NULL,
+                  "Handle one tuning/telemetry protocol request: <hex>",
+                  cmd_paw32xx_rpc, 2, 0),
+#endif
+#if defined(CONFIG_PAW3222_EMUL) && defined(CONFIG_PAW3222_STATS)
+    SHELL_CMD_ARG(storm, NULL,
+                  "Run an emulated IRQ storm with saturating motion and "
+                  "mode switching: <ms> [irq_period_us]",
+                  cmd_paw32xx_storm, 2, 1),
+#endif
+    SHELL_CMD(reinit, NULL, "Reset and reconfigure the sensor",
+              cmd_paw32xx_reinit),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(paw3222, &sub_paw32xx, "PAW3222 diagnostics and tuning",
+                   NULL);
+
+#endif // DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
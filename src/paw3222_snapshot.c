@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_latency.h"
+#include "paw3222_snapshot.h"
+#include "paw3222_trace.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+BUILD_ASSERT(sizeof(struct paw32xx_snapshot) <= UINT16_MAX);
+
+#define PAW32XX_SNAPSHOT_CRC_OFFSET                                            \
+  (offsetof(struct paw32xx_snapshot, crc) + sizeof(uint32_t))
+
+static uint32_t paw32xx_snapshot_crc(const struct paw32xx_snapshot *snap) {
+  return crc32_ieee((const uint8_t *)snap + PAW32XX_SNAPSHOT_CRC_OFFSET,
+                    sizeof(*snap) - PAW32XX_SNAPSHOT_CRC_OFFSET);
+}
+
+static bool paw32xx_snapshot_valid(const struct paw32xx_snapshot *snap) {
+  return snap->magic == PAW32XX_SNAPSHOT_MAGIC &&
+         snap->version == PAW32XX_SNAPSHOT_VERSION &&
+         snap->size == sizeof(*snap) &&
+         snap->crc == paw32xx_snapshot_crc(snap);
+}
+
+/* Newer boot first, then the later save of the same boot */
+static bool paw32xx_snapshot_newer(const struct paw32xx_snapshot *a,
+                                   const struct paw32xx_snapshot *b) {
+  if (a->boot != b->boot) {
+    return (int32_t)(a->boot - b->boot) > 0;
+  }
+  return (int32_t)(a->seq - b->seq) > 0;
+}
+
+static void paw32xx_snapshot_fill(const struct device *dev,
+                                  struct paw32xx_snapshot *snap) {
+  struct paw32xx_data *data = dev->data;
+#ifdef CONFIG_PAW3222_TRACE
+  uint32_t first, next;
+#endif
+
+  snap->boot = data->snapshot.boot;
+  snap->seq = data->snapshot.seq;
+  snap->uptime_ms = k_uptime_get_32();
+  snap->idle = data->idle_sm.idle;
+  snap->input_mode = data->input_mode;
+  snap->cpi = data->current_cpi;
+
+#ifdef CONFIG_PAW3222_STATS
+  snap->stats = data->stats;
+#endif
+
+#ifdef CONFIG_PAW3222_LATENCY
+  for (int i = 0; i < PAW32XX_LATENCY_STAGE_COUNT; i++) {
+    uint32_t buckets[PAW32XX_LATENCY_BUCKETS];
+
+    paw32xx_latency_get(dev, i, buckets, &snap->latency_max_us[i]);
+  }
+#endif
+
+#ifdef CONFIG_PAW3222_TRACE
+  paw32xx_trace_range(dev, &first, &next);
+  if (next - first > CONFIG_PAW3222_SNAPSHOT_TRACE_RECS) {
+    first = next - CONFIG_PAW3222_SNAPSHOT_TRACE_RECS;
+  }
+  snap->trace_count = 0;
+  for (uint32_t seq = first; seq != next; seq++) {
+    /* Overwritten while copying: keep what follows without a gap */
+    if (paw32xx_trace_get(dev, seq, &snap->trace[snap->trace_count]) < 0) {
+      snap->trace_count = 0;
+      first = seq + 1;
+      continue;
+    }
+    snap->trace_count++;
+  }
+  snap->trace_seq = first;
+#endif
+}
+
+static void paw32xx_snapshot_handler(struct k_work *work) {
+  struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+  struct paw32xx_snapshot_state *state =
+      CONTAINER_OF(dwork, struct paw32xx_snapshot_state, work);
+  struct paw32xx_data *data =
+      CONTAINER_OF(state, struct paw32xx_data, snapshot);
+  const struct device *dev = data->dev;
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_snapshot *snap = &cfg->snapshot->slot[state->seq & 1];
+
+  /* Invalid while being written; the other slot stays the newest */
+  memset(snap, 0, sizeof(*snap));
+  snap->version = PAW32XX_SNAPSHOT_VERSION;
+  snap->size = sizeof(*snap);
+  paw32xx_snapshot_fill(dev, snap);
+  snap->crc = paw32xx_snapshot_crc(snap);
+  snap->magic = PAW32XX_SNAPSHOT_MAGIC;
+  state->seq++;
+
+  /* Nothing changes while idle; the idle exit asks for the next save */
+  if (!data->idle_sm.idle) {
+    k_work_schedule(&state->work, K_MSEC(CONFIG_PAW3222_SNAPSHOT_PERIOD_MS));
+  }
+}
+
+void paw32xx_snapshot_init(const struct device *dev) {
+  const struct paw32xx_config *cfg = dev->config;
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_snapshot_state *state = &data->snapshot;
+  const struct paw32xx_snapshot *newest = NULL;
+
+  for (size_t i = 0; i < ARRAY_SIZE(cfg->snapshot->slot); i++) {
+    const struct paw32xx_snapshot *snap = &cfg->snapshot->slot[i];
+
+    if (paw32xx_snapshot_valid(snap) &&
+        (newest == NULL || paw32xx_snapshot_newer(snap, newest))) {
+      newest = snap;
+    }
+  }
+
+  state->prev_valid = newest != NULL;
+  state->seq = 0;
+  if (newest != NULL) {
+    state->prev = *newest;
+    state->boot = newest->boot + 1;
+    LOG_INF("Snapshot of boot %u: %u ms uptime, %s, %u saves",
+            newest->boot, newest->uptime_ms,
+            newest->idle ? "idle" : "active", newest->seq + 1);
+  } else {
+    state->boot = 0;
+  }
+
+  k_work_init_delayable(&state->work, paw32xx_snapshot_handler);
+  k_work_schedule(&state->work, K_MSEC(CONFIG_PAW3222_SNAPSHOT_PERIOD_MS));
+}
+
+void paw32xx_snapshot_request(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+
+  k_work_reschedule(&data->snapshot.work, K_NO_WAIT);
+}
+
+int paw32xx_snapshot_prev(const struct device *dev,
+                          struct paw32xx_snapshot *snap) {
+  struct paw32xx_data *data = dev->data;
+
+  if (!data->snapshot.prev_valid) {
+    return -ENODATA;
+  }
+
+  *snap = data->snapshot.prev;
+  return 0;
+}
@@ -13,17 +13,12 @@
 #include <zephyr/logging/log.h>
 
 #include "paw3222.h"
+#include "paw3222_core.h"
 #include "paw3222_regs.h"
 #include "paw3222_spi.h"
 
 LOG_MODULE_DECLARE(paw32xx);
 
-static inline int32_t sign_extend(uint32_t value, uint8_t index) {
-    __ASSERT_NO_MSG(index <= 31);
-    uint8_t shift = 31 - index;
-    return (int32_t)(value << shift) >> shift;
-}
-
 int paw32xx_read_reg(const struct device *dev, uint8_t addr, uint8_t *value) {
     const struct paw32xx_config *cfg = dev->config;
     int ret;
@@ -128,8 +123,8 @@ int paw32xx_read_xy(const struct device *dev, int16_t *x, int16_t *y) {
     }
 
     // Apply sign extension directly to the 8-bit values
-    *x = sign_extend(rx_data[1], PAW32XX_DATA_SIZE_BITS - 1);
-    *y = sign_extend(rx_data[3], PAW32XX_DATA_SIZE_BITS - 1);
+    *x = paw32xx_core_sign_extend(rx_data[1]);
+    *y = paw32xx_core_sign_extend(rx_data[3]);
 
     return 0;
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * ZMK Studio custom RPC subsystem carrying the paw3222_rpc.h protocol.
+ *
+ * The subsystem payload is a paw3222.Request (proto/paw3222/rpc.proto)
+ * holding the instance index and the request bytes; the reply is a
+ * paw3222.Response with the response bytes. Requests are handled on the
+ * Studio RPC thread through paw32xx_rpc_handle(), which never waits for
+ * the motion work.
+ */
+
+#if !__has_include(<zmk/studio/custom.h>)
+#error "CONFIG_PAW3222_STUDIO_RPC needs a ZMK with custom Studio RPC subsystems"
+#endif
+
+#include <errno.h>
+
+#include <pb_decode.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include <zmk/studio/custom.h>
+
+#include "paw3222_rpc.h"
+#include "proto/paw3222/rpc.pb.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define DT_DRV_COMPAT pixart_paw3222
+
+#define PAW32XX_DEVICE_ENTRY(n) DEVICE_DT_INST_GET(n),
+
+static const struct device *const paw32xx_studio_devices[] = {
+    DT_INST_FOREACH_STATUS_OKAY(PAW32XX_DEVICE_ENTRY)};
+
+BUILD_ASSERT(sizeof(((paw3222_Response *)0)->payload.bytes) >=
+                 PAW32XX_RPC_MAX_RESP,
+             "rpc.options: Response.payload smaller than PAW32XX_RPC_MAX_RESP");
+
+static bool paw32xx_studio_handle(const zmk_custom_CallRequest *raw,
+                                  pb_callback_t *encode_response);
+
+static struct zmk_rpc_custom_subsystem_meta paw32xx_studio_meta = {
+    .security = ZMK_STUDIO_RPC_HANDLER_SECURED,
+};
+
+ZMK_RPC_CUSTOM_SUBSYSTEM(nuovotaka__paw3222, &paw32xx_studio_meta,
+                         paw32xx_studio_handle);
+ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER(nuovotaka__paw3222, paw3222_Response);
+
+static bool paw32xx_studio_handle(const zmk_custom_CallRequest *raw,
+                                  pb_callback_t *encode_response) {
+  paw3222_Response *resp = ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER_ALLOCATE(
+      nuovotaka__paw3222, encode_response);
+  paw3222_Request req = paw3222_Request_init_zero;
+  pb_istream_t stream =
+      pb_istream_from_buffer(raw->payload.bytes, raw->payload.size);
+  int ret;
+
+  if (!pb_decode(&stream, paw3222_Request_fields, &req)) {
+    LOG_WRN("Studio RPC: undecodable request: %s", PB_GET_ERROR(&stream));
+    return false;
+  }
+  if (req.instance >= ARRAY_SIZE(paw32xx_studio_devices)) {
+    LOG_WRN("Studio RPC: no PAW3222 instance %u", req.instance);
+    return false;
+  }
+
+  ret = paw32xx_rpc_handle(paw32xx_studio_devices[req.instance],
+                           req.payload.bytes, req.payload.size,
+                           resp->payload.bytes, sizeof(resp->payload.bytes));
+  if (ret < 0) {
+    LOG_WRN("Studio RPC: request not handled: %d", ret);
+    return false;
+  }
+
+  resp->payload.size = ret;
+  return true;
+}
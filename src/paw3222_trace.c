@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "paw3222.h"
+#include "paw3222_trace.h"
+
+LOG_MODULE_DECLARE(paw32xx);
+
+#define PAW32XX_TRACE_DEPTH CONFIG_PAW3222_TRACE_DEPTH
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PAW32XX_TRACE_DEPTH),
+             "CONFIG_PAW3222_TRACE_DEPTH must be a power of two");
+
+void paw32xx_trace_record(const struct device *dev, uint8_t type, uint8_t arg,
+                          int16_t a, int16_t b) {
+  struct paw32xx_data *data = dev->data;
+  struct paw32xx_trace_rec *rec;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->trace.lock);
+  rec = &data->trace.recs[data->trace.next_seq & (PAW32XX_TRACE_DEPTH - 1)];
+  rec->cycles = k_cycle_get_32();
+  rec->type = type;
+  rec->arg = arg;
+  rec->a = a;
+  rec->b = b;
+  data->trace.next_seq++;
+  k_spin_unlock(&data->trace.lock, key);
+}
+
+void paw32xx_trace_range(const struct device *dev, uint32_t *first,
+                         uint32_t *next) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->trace.lock);
+  *next = data->trace.next_seq;
+  *first = (*next > PAW32XX_TRACE_DEPTH) ? *next - PAW32XX_TRACE_DEPTH : 0;
+  k_spin_unlock(&data->trace.lock, key);
+}
+
+int paw32xx_trace_get(const struct device *dev, uint32_t seq,
+                      struct paw32xx_trace_rec *rec) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+  int ret = 0;
+
+  key = k_spin_lock(&data->trace.lock);
+  if (seq >= data->trace.next_seq ||
+      data->trace.next_seq - seq > PAW32XX_TRACE_DEPTH) {
+    ret = -ENOENT;
+  } else {
+    *rec = data->trace.recs[seq & (PAW32XX_TRACE_DEPTH - 1)];
+  }
+  k_spin_unlock(&data->trace.lock, key);
+
+  return ret;
+}
+
+void paw32xx_trace_clear(const struct device *dev) {
+  struct paw32xx_data *data = dev->data;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&data->trace.lock);
+  data->trace.next_seq = 0;
+  k_spin_unlock(&data->trace.lock, key);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Minimal stand-in for ZMK's event manager: raising an event only counts
+ * it, and listeners are kept referenced but never called. Tests call the
+ * driver's layer hook directly instead.
+ */
+
+#ifndef ZMK_EVENT_MANAGER_H_
+#define ZMK_EVENT_MANAGER_H_
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+typedef struct {
+  uint8_t unused;
+} zmk_event_t;
+
+#define ZMK_EV_EVENT_BUBBLE 0
+#define ZMK_EV_EVENT_HANDLED 1
+#define ZMK_EV_EVENT_CAPTURED 2
+
+#define ZMK_EVENT_DECLARE(event_type)                                          \
+  extern uint32_t event_type##_raised;                                         \
+  static inline int raise_##event_type(struct event_type ev) {                 \
+    ARG_UNUSED(ev);                                                            \
+    event_type##_raised++;                                                     \
+    return 0;                                                                  \
+  }
+
+#define ZMK_EVENT_IMPL(event_type) uint32_t event_type##_raised
+
+#define ZMK_LISTENER(mod, cb)                                                  \
+  static int (*const zmk_listener_##mod)(const zmk_event_t *) __used = cb
+
+#define ZMK_SUBSCRIPTION(mod, ev_type) struct zmk_subscription_##mod##_##ev_type
+
+#endif /* ZMK_EVENT_MANAGER_H_ */
@@ -0,0 +1,22 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZMK_EVENTS_LAYER_STATE_CHANGED_H_
+#define ZMK_EVENTS_LAYER_STATE_CHANGED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zmk/event_manager.h>
+
+struct zmk_layer_state_changed {
+  uint8_t layer;
+  bool state;
+  int64_t timestamp;
+};
+
+ZMK_EVENT_DECLARE(zmk_layer_state_changed);
+
+#endif /* ZMK_EVENTS_LAYER_STATE_CHANGED_H_ */
@@ -0,0 +1,21 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZMK_KEYMAP_H_
+#define ZMK_KEYMAP_H_
+
+#include <stdint.h>
+
+uint8_t zmk_keymap_highest_layer_active(void);
+
+/**
+ * @brief Set the layer the fake keymap reports as highest active
+ *
+ * @param layer Layer index
+ */
+void zmk_fake_set_layer(uint8_t layer);
+
+#endif /* ZMK_KEYMAP_H_ */
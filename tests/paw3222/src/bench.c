@@ -0,0 +1,288 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * native_sim runs code in no simulated time, so cycle counts are all zero
+ * here. The cost of an operation is measured in what the emulator and the
+ * driver can count exactly instead: register reads and writes on the bus,
+ * motion work runs and reports. Those are deterministic, so the tolerance
+ * only absorbs intended small changes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "paw3222.h"
+#include "paw3222_emul.h"
+#include "paw3222_input.h"
+#include "paw3222_params.h"
+#include "paw3222_test.h"
+
+/** @brief Operations per measurement; costs are reported per this many */
+#define PAW32XX_BENCH_OPS 100
+
+/** @brief Allowed deviation from the baseline, in percent */
+#define PAW32XX_BENCH_TOLERANCE_PCT 10
+
+/** @brief Idle entry/exit cycles measured; scaled to PAW32XX_BENCH_OPS */
+#define PAW32XX_BENCH_IDLE_CYCLES 10
+
+/* Large enough that every sample emits in every mode, even after the snipe
+ * divisor, and still fits the 8-bit delta registers when doubled. */
+#define PAW32XX_BENCH_DX 60
+#define PAW32XX_BENCH_DY -60
+
+/** @brief Layer selecting snipe mode, see boards/native_sim.overlay */
+#define PAW32XX_BENCH_SNIPE_LAYER PAW32XX_SNIPE
+
+static const char paw32xx_bench_baseline_csv[] = {
+#include "bench_baseline.csv.inc"
+    '\0'};
+
+/**
+ * @brief Cost of PAW32XX_BENCH_OPS operations
+ */
+struct paw32xx_bench_cost {
+  uint32_t spi_reads;  /**< Register reads seen by the emulator */
+  uint32_t spi_writes; /**< Register writes accepted by the emulator */
+  uint32_t work_runs;  /**< Motion work handler runs */
+  uint32_t reports;    /**< Synced reports */
+};
+
+struct paw32xx_bench_snap {
+  struct paw32xx_emul_stats emul;
+  struct paw32xx_stats drv;
+};
+
+/* Sample ops in enum paw32xx_input_mode order; the overlay maps layer n to
+ * mode n. BOTHSCROLL_SNIPE has no layer property and is not measured. */
+static const char *const paw32xx_bench_sample_ops[] = {
+    "sample_move",
+    "sample_scroll",
+    "sample_scroll_horizontal",
+    "sample_snipe",
+    "sample_scroll_snipe",
+    "sample_scroll_horizontal_snipe",
+    "sample_bothscroll",
+};
+
+/* Frames the motion source still has to deliver */
+static uint32_t paw32xx_bench_frames;
+
+static void paw32xx_bench_source(const struct emul *target, int16_t *dx,
+                                 int16_t *dy, void *user_data) {
+  ARG_UNUSED(target);
+  ARG_UNUSED(user_data);
+
+  if (paw32xx_bench_frames > 0) {
+    paw32xx_bench_frames--;
+    *dx = PAW32XX_BENCH_DX;
+    *dy = PAW32XX_BENCH_DY;
+  }
+}
+
+static void paw32xx_bench_snap(struct paw32xx_bench_snap *snap) {
+  const struct paw32xx_data *data = paw32xx_test_dev()->data;
+
+  /* Only taken with the driver settled */
+  paw32xx_emul_get_stats(paw32xx_test_emul(), &snap->emul);
+  snap->drv = data->stats;
+}
+
+static void paw32xx_bench_cost(const struct paw32xx_bench_snap *before,
+                               const struct paw32xx_bench_snap *after,
+                               uint32_t ops, struct paw32xx_bench_cost *cost) {
+  uint32_t scale = PAW32XX_BENCH_OPS / ops;
+
+  cost->spi_reads = (after->emul.reg_reads - before->emul.reg_reads) * scale;
+  cost->spi_writes = (after->emul.reg_writes - before->emul.reg_writes) * scale;
+  cost->work_runs = (after->drv.work_runs - before->drv.work_runs) * scale;
+  cost->reports = (after->drv.reports - before->drv.reports) * scale;
+}
+
+/**
+ * @brief Find the baseline row of an operation
+ *
+ * @retval 0 Row found
+ * @retval -ENOENT No row for @p op
+ */
+static int paw32xx_bench_baseline(const char *op,
+                                  struct paw32xx_bench_cost *cost) {
+  size_t op_len = strlen(op);
+  const char *line = paw32xx_bench_baseline_csv;
+
+  while (*line != '\0') {
+    const char *next = strchr(line, '\n');
+    char *end;
+
+    if (next == NULL) {
+      next = line + strlen(line);
+    }
+
+    if (strncmp(line, op, op_len) == 0 && line[op_len] == ',') {
+      cost->spi_reads = strtoul(&line[op_len + 1], &end, 10);
+      cost->spi_writes = strtoul(end + 1, &end, 10);
+      cost->work_runs = strtoul(end + 1, &end, 10);
+      cost->reports = strtoul(end + 1, &end, 10);
+      return 0;
+    }
+
+    line = (*next == '\n') ? next + 1 : next;
+  }
+
+  return -ENOENT;
+}
+
+static void paw32xx_bench_check_one(const char *op, const char *column,
+                                    uint32_t measured, uint32_t baseline) {
+  uint32_t tolerance = baseline * PAW32XX_BENCH_TOLERANCE_PCT / 100;
+
+  zassert_within(measured, baseline, tolerance,
+                 "%s: %s is %u, baseline %u +/- %u; update "
+                 "bench_baseline.csv if the change is intended",
+                 op, column, measured, baseline, tolerance);
+}
+
+/**
+ * @brief Print the cost as a baseline row and compare it with the baseline
+ */
+static void paw32xx_bench_check(const char *op,
+                                const struct paw32xx_bench_cost *cost) {
+  struct paw32xx_bench_cost base;
+
+  TC_PRINT("bench,%s,%u,%u,%u,%u\n", op, cost->spi_reads, cost->spi_writes,
+           cost->work_runs, cost->reports);
+
+  zassert_ok(paw32xx_bench_baseline(op, &base), "%s: no baseline row", op);
+  paw32xx_bench_check_one(op, "spi_reads", cost->spi_reads, base.spi_reads);
+  paw32xx_bench_check_one(op, "spi_writes", cost->spi_writes, base.spi_writes);
+  paw32xx_bench_check_one(op, "work_runs", cost->work_runs, base.work_runs);
+  paw32xx_bench_check_one(op, "reports", cost->reports, base.reports);
+}
+
+static void paw32xx_bench_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  paw32xx_test_reset();
+}
+
+static void paw32xx_bench_after(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  zassert_ok(paw32xx_param_set(paw32xx_test_dev(), PAW32XX_PARAM_IDLE_TIMEOUT_S,
+                               CONFIG_PAW3222_IDLE_TIMEOUT_SECONDS));
+}
+
+ZTEST(paw3222_bench, test_sample) {
+  const struct device *dev = paw32xx_test_dev();
+  const struct paw32xx_data *data = dev->data;
+  struct paw32xx_bench_snap before, after;
+  struct paw32xx_bench_cost cost;
+
+  for (uint8_t mode = 0; mode < ARRAY_SIZE(paw32xx_bench_sample_ops); mode++) {
+    paw32xx_test_set_layer(mode);
+    zassert_equal(data->input_mode, mode, "layer %u not mapped to its mode",
+                  mode);
+
+    /* Warm up: the CPI of the mode is written by the first sample */
+    paw32xx_emul_add_motion(paw32xx_test_emul(), 1, 1);
+    paw32xx_test_settle();
+    paw32xx_apply_mode(dev);
+    paw32xx_test_settle();
+
+    paw32xx_bench_snap(&before);
+    paw32xx_bench_frames = PAW32XX_BENCH_OPS;
+    paw32xx_emul_set_motion_source(paw32xx_test_emul(), paw32xx_bench_source,
+                                   NULL);
+    /* The edge; its motion joins the source's first frame */
+    paw32xx_emul_add_motion(paw32xx_test_emul(), PAW32XX_BENCH_DX,
+                            PAW32XX_BENCH_DY);
+    k_sleep(K_MSEC(PAW32XX_BENCH_OPS * PAW32XX_POLL_INTERVAL_MS));
+    paw32xx_test_settle();
+    paw32xx_emul_set_motion_source(paw32xx_test_emul(), NULL, NULL);
+    paw32xx_bench_snap(&after);
+
+    zassert_equal(paw32xx_bench_frames, 0, "source not drained");
+    zassert_equal(after.drv.samples - before.drv.samples, PAW32XX_BENCH_OPS);
+    paw32xx_bench_cost(&before, &after, PAW32XX_BENCH_OPS, &cost);
+    paw32xx_bench_check(paw32xx_bench_sample_ops[mode], &cost);
+  }
+}
+
+ZTEST(paw3222_bench, test_mode_resolve) {
+  struct paw32xx_bench_snap before, after;
+  struct paw32xx_bench_cost cost;
+
+  /* A layer change resolves the mode; it must not touch the sensor */
+  paw32xx_bench_snap(&before);
+  for (uint32_t i = 1; i <= PAW32XX_BENCH_OPS; i++) {
+    paw32xx_test_set_layer(i % ARRAY_SIZE(paw32xx_bench_sample_ops));
+  }
+  paw32xx_test_settle();
+  paw32xx_bench_snap(&after);
+
+  zassert_equal(after.drv.mode_changes - before.drv.mode_changes,
+                PAW32XX_BENCH_OPS);
+  paw32xx_bench_cost(&before, &after, PAW32XX_BENCH_OPS, &cost);
+  paw32xx_bench_check("mode_resolve", &cost);
+}
+
+ZTEST(paw3222_bench, test_cpi_switch) {
+  struct paw32xx_bench_snap before, after;
+  struct paw32xx_bench_cost cost;
+
+  /* Every sample alternates between the default and the snipe CPI */
+  paw32xx_bench_snap(&before);
+  for (uint32_t i = 1; i <= PAW32XX_BENCH_OPS; i++) {
+    paw32xx_test_set_layer((i % 2) ? PAW32XX_BENCH_SNIPE_LAYER : 0);
+    paw32xx_emul_add_motion(paw32xx_test_emul(), PAW32XX_BENCH_DX,
+                            PAW32XX_BENCH_DY);
+    paw32xx_test_settle();
+  }
+  paw32xx_bench_snap(&after);
+
+  zassert_equal(after.drv.cpi_writes - before.drv.cpi_writes,
+                PAW32XX_BENCH_OPS);
+  paw32xx_bench_cost(&before, &after, PAW32XX_BENCH_OPS, &cost);
+  paw32xx_bench_check("cpi_switch", &cost);
+}
+
+ZTEST(paw3222_bench, test_idle_cycle) {
+  struct paw32xx_bench_snap before, after;
+  struct paw32xx_bench_cost cost;
+  k_timeout_t idle = K_MSEC(MSEC_PER_SEC + PAW32XX_TEST_SETTLE_MS);
+
+  zassert_ok(paw32xx_param_set(paw32xx_test_dev(),
+                               PAW32XX_PARAM_IDLE_TIMEOUT_S, 1));
+
+  /* Start from idle; each cycle is one wake, one sample and one entry */
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 1, 1);
+  paw32xx_test_settle();
+  k_sleep(idle);
+
+  paw32xx_bench_snap(&before);
+  for (uint32_t i = 0; i < PAW32XX_BENCH_IDLE_CYCLES; i++) {
+    paw32xx_emul_add_motion(paw32xx_test_emul(), PAW32XX_BENCH_DX,
+                            PAW32XX_BENCH_DY);
+    paw32xx_test_settle();
+    k_sleep(idle);
+  }
+  paw32xx_bench_snap(&after);
+
+  zassert_equal(after.drv.idle_exits - before.drv.idle_exits,
+                PAW32XX_BENCH_IDLE_CYCLES);
+  zassert_equal(after.drv.idle_entries - before.drv.idle_entries,
+                PAW32XX_BENCH_IDLE_CYCLES);
+  paw32xx_bench_cost(&before, &after, PAW32XX_BENCH_IDLE_CYCLES, &cost);
+  paw32xx_bench_check("idle_cycle", &cost);
+}
+
+ZTEST_SUITE(paw3222_bench, NULL, NULL, paw32xx_bench_before,
+            paw32xx_bench_after, NULL);
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/input/input.h>
+#include <zephyr/kernel.h>
+
+#include <zmk/keymap.h>
+
+#include "paw3222.h"
+#include "paw3222_emul.h"
+#include "paw3222_input.h"
+#include "paw3222_test.h"
+
+#define PAW32XX_TEST_NODE DT_NODELABEL(trackball)
+
+struct paw32xx_test_capture paw32xx_test_capture;
+
+static void paw32xx_test_input_cb(struct input_event *evt) {
+  struct paw32xx_test_capture *cap = &paw32xx_test_capture;
+
+  switch (evt->code) {
+  case INPUT_REL_X:
+    cap->rel_x += evt->value;
+    break;
+  case INPUT_REL_Y:
+    cap->rel_y += evt->value;
+    break;
+  case INPUT_REL_WHEEL:
+    cap->wheel += evt->value;
+    break;
+  case INPUT_REL_HWHEEL:
+    cap->hwheel += evt->value;
+    break;
+  default:
+    break;
+  }
+
+  cap->events++;
+  if (evt->sync) {
+    cap->syncs++;
+  }
+}
+
+INPUT_CALLBACK_DEFINE(DEVICE_DT_GET(PAW32XX_TEST_NODE), paw32xx_test_input_cb);
+
+const struct device *paw32xx_test_dev(void) {
+  return DEVICE_DT_GET(PAW32XX_TEST_NODE);
+}
+
+const struct emul *paw32xx_test_emul(void) {
+  return EMUL_DT_GET(PAW32XX_TEST_NODE);
+}
+
+void paw32xx_test_settle(void) { k_sleep(K_MSEC(PAW32XX_TEST_SETTLE_MS)); }
+
+void paw32xx_test_set_layer(uint8_t layer) {
+  zmk_fake_set_layer(layer);
+  /* What the driver's layer_state_changed listener does */
+  paw32xx_update_effective_mode(paw32xx_test_dev());
+}
+
+void paw32xx_test_reset(void) {
+  const struct emul *emul = paw32xx_test_emul();
+
+  paw32xx_emul_storm_stop(emul);
+  paw32xx_emul_set_motion_source(emul, NULL, NULL);
+  paw32xx_test_set_layer(0);
+  paw32xx_test_settle();
+  memset(&paw32xx_test_capture, 0, sizeof(paw32xx_test_capture));
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The invariants tools/host/paw3222_idle_sim checks on its model, checked
+ * on the driver itself: idle is not entered before the timeout, set_sleep()
+ * requests alternate starting with sleep, the sensor is not read while
+ * asleep, motion wakes it and is read at once, and the first poll after
+ * the wake uses the reduced-scan interval when that is enabled.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "paw3222.h"
+#include "paw3222_emul.h"
+#include "paw3222_params.h"
+#include "paw3222_power.h"
+#include "paw3222_test.h"
+
+/** @brief Idle timeout used by this suite, in seconds */
+#define PAW32XX_IDLE_TEST_TIMEOUT_S 1
+
+#define PAW32XX_IDLE_TEST_DX 12
+#define PAW32XX_IDLE_TEST_DY -8
+
+/**
+ * @brief What the board hook saw since the driver started
+ */
+static struct {
+  bool asleep;             /**< State of the last request */
+  uint32_t sleeps;         /**< Sleep requests */
+  uint32_t wakes;          /**< Wake requests */
+  uint32_t repeats;        /**< Requests for the state already requested */
+  uint32_t asleep_reads;   /**< Register reads between a sleep and its wake */
+  uint32_t reads_at_sleep; /**< Emulator register reads at the last sleep */
+  int64_t sleep_ms;        /**< Uptime of the last sleep request */
+  int64_t wake_ms;         /**< Uptime of the last wake request */
+} paw32xx_idle_log;
+
+/* Overrides the weak default in paw3222_power.c (CONFIG_PAW3222_POWER_CTRL) */
+int paw3222_set_sleep(const struct device *dev, bool sleep) {
+  struct paw32xx_emul_stats stats;
+
+  ARG_UNUSED(dev);
+
+  paw32xx_emul_get_stats(paw32xx_test_emul(), &stats);
+  if (sleep == paw32xx_idle_log.asleep) {
+    paw32xx_idle_log.repeats++;
+  }
+  if (sleep) {
+    paw32xx_idle_log.sleeps++;
+    paw32xx_idle_log.sleep_ms = k_uptime_get();
+    paw32xx_idle_log.reads_at_sleep = stats.reg_reads;
+  } else {
+    paw32xx_idle_log.wakes++;
+    paw32xx_idle_log.wake_ms = k_uptime_get();
+    if (paw32xx_idle_log.asleep) {
+      paw32xx_idle_log.asleep_reads +=
+          stats.reg_reads - paw32xx_idle_log.reads_at_sleep;
+    }
+  }
+  paw32xx_idle_log.asleep = sleep;
+
+  return 0;
+}
+
+static uint32_t paw32xx_idle_test_reads(void) {
+  struct paw32xx_emul_stats stats;
+
+  paw32xx_emul_get_stats(paw32xx_test_emul(), &stats);
+  return stats.reg_reads;
+}
+
+/* Awake with a fresh timeout; returns the uptime of the last sample */
+static int64_t paw32xx_idle_test_active(void) {
+  int64_t t;
+
+  t = k_uptime_get();
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 1, 1);
+  paw32xx_test_settle();
+  return t;
+}
+
+/* Asleep, with nothing pending */
+static void paw32xx_idle_test_sleep(void) {
+  paw32xx_idle_test_active();
+  k_sleep(K_MSEC(PAW32XX_IDLE_TEST_TIMEOUT_S * MSEC_PER_SEC +
+                 PAW32XX_TEST_SETTLE_MS));
+  zassert_true(paw32xx_idle_log.asleep, "idle not entered");
+}
+
+static void paw32xx_idle_test_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  paw32xx_test_reset();
+  zassert_ok(paw32xx_param_set(paw32xx_test_dev(),
+                               PAW32XX_PARAM_IDLE_TIMEOUT_S,
+                               PAW32XX_IDLE_TEST_TIMEOUT_S));
+}
+
+static void paw32xx_idle_test_after(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  zassert_equal(paw32xx_idle_log.repeats, 0,
+                "set_sleep() requests do not alternate");
+  zassert_equal(paw32xx_idle_log.asleep_reads, 0,
+                "sensor read while asleep");
+
+  /* Leave the sensor awake for the other suites */
+  paw32xx_idle_test_active();
+  zassert_ok(paw32xx_param_set(paw32xx_test_dev(), PAW32XX_PARAM_IDLE_TIMEOUT_S,
+                               CONFIG_PAW3222_IDLE_TIMEOUT_SECONDS));
+}
+
+ZTEST(paw3222_idle, test_entry_after_timeout) {
+  const struct paw32xx_data *data = paw32xx_test_dev()->data;
+  uint32_t sleeps;
+  int64_t t0;
+
+  t0 = paw32xx_idle_test_active();
+  sleeps = paw32xx_idle_log.sleeps;
+
+  /* Polls end with the motion; nothing but the timeout may sleep */
+  k_sleep(K_TIMEOUT_ABS_MS(t0 + PAW32XX_IDLE_TEST_TIMEOUT_S * MSEC_PER_SEC -
+                           data->tune.poll_ms));
+  zassert_equal(paw32xx_idle_log.sleeps, sleeps, "idle entered early");
+
+  k_sleep(K_TIMEOUT_ABS_MS(t0 + PAW32XX_IDLE_TEST_TIMEOUT_S * MSEC_PER_SEC +
+                           PAW32XX_TEST_SETTLE_MS));
+  zassert_equal(paw32xx_idle_log.sleeps, sleeps + 1, "idle not entered");
+  zassert_within(paw32xx_idle_log.sleep_ms - t0,
+                 PAW32XX_IDLE_TEST_TIMEOUT_S * MSEC_PER_SEC, data->tune.poll_ms,
+                 "idle entered %lld ms after the sample",
+                 (long long)(paw32xx_idle_log.sleep_ms - t0));
+
+  /* Once: a quiet sensor does not leave idle on its own */
+  k_sleep(K_SECONDS(PAW32XX_IDLE_TEST_TIMEOUT_S));
+  zassert_equal(paw32xx_idle_log.sleeps, sleeps + 1);
+  zassert_true(paw32xx_idle_log.asleep);
+}
+
+ZTEST(paw3222_idle, test_wake_on_motion) {
+  uint32_t reads, wakes;
+  int64_t t;
+
+  paw32xx_idle_test_sleep();
+  memset(&paw32xx_test_capture, 0, sizeof(paw32xx_test_capture));
+  wakes = paw32xx_idle_log.wakes;
+
+  /* No polling while asleep */
+  reads = paw32xx_idle_test_reads();
+  k_sleep(K_MSEC(PAW32XX_TEST_SETTLE_MS));
+  zassert_equal(paw32xx_idle_test_reads(), reads,
+                "sensor polled while asleep");
+
+  t = k_uptime_get();
+  paw32xx_emul_add_motion(paw32xx_test_emul(), PAW32XX_IDLE_TEST_DX,
+                          PAW32XX_IDLE_TEST_DY);
+  paw32xx_test_settle();
+
+  zassert_equal(paw32xx_idle_log.wakes, wakes + 1, "motion did not wake");
+  zassert_false(paw32xx_idle_log.asleep);
+  zassert_true(paw32xx_idle_log.wake_ms - t <= PAW32XX_POLL_INTERVAL_MS,
+               "woken %lld ms after the motion",
+               (long long)(paw32xx_idle_log.wake_ms - t));
+  zassert_equal(paw32xx_test_capture.rel_x, PAW32XX_IDLE_TEST_DX);
+  zassert_equal(paw32xx_test_capture.rel_y, PAW32XX_IDLE_TEST_DY);
+  zassert_equal(paw32xx_test_capture.syncs, 1, "one sample, one report");
+}
+
+ZTEST(paw3222_idle, test_first_poll_after_wake) {
+  const struct paw32xx_data *data = paw32xx_test_dev()->data;
+  uint32_t interval = IS_ENABLED(CONFIG_PAW3222_REDUCED_SCAN)
+                          ? data->tune.reduced_scan_ms
+                          : data->tune.poll_ms;
+  uint32_t reads;
+  int64_t t;
+
+  paw32xx_idle_test_sleep();
+
+  /* The wake reads MOTION, DELTA_X and DELTA_Y; the first poll MOTION */
+  reads = paw32xx_idle_test_reads();
+  t = k_uptime_get();
+  paw32xx_emul_add_motion(paw32xx_test_emul(), PAW32XX_IDLE_TEST_DX,
+                          PAW32XX_IDLE_TEST_DY);
+
+  k_sleep(K_TIMEOUT_ABS_MS(t + interval - data->tune.poll_ms / 2));
+  zassert_equal(paw32xx_idle_test_reads() - reads, 3, "polled before %u ms",
+                interval);
+  k_sleep(K_TIMEOUT_ABS_MS(t + interval + data->tune.poll_ms / 2));
+  zassert_equal(paw32xx_idle_test_reads() - reads, 4, "no poll at %u ms",
+                interval);
+}
+
+ZTEST_SUITE(paw3222_idle, NULL, NULL, paw32xx_idle_test_before,
+            paw32xx_idle_test_after, NULL);
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PAW3222_TEST_H_
+#define PAW3222_TEST_H_
+
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+
+#include "paw3222.h"
+
+/** @brief Time for the driver to read pending motion and see it stop, in ms */
+#define PAW32XX_TEST_SETTLE_MS (5 * PAW32XX_POLL_INTERVAL_MS)
+
+/**
+ * @brief Input events the driver reported since the last reset
+ */
+struct paw32xx_test_capture {
+  int32_t rel_x;   /**< Sum of REL_X values */
+  int32_t rel_y;   /**< Sum of REL_Y values */
+  int32_t wheel;   /**< Sum of REL_WHEEL values */
+  int32_t hwheel;  /**< Sum of REL_HWHEEL values */
+  uint32_t events; /**< Events of any code */
+  uint32_t syncs;  /**< Events with the sync flag, i.e. reports */
+};
+
+extern struct paw32xx_test_capture paw32xx_test_capture;
+
+/** @brief The PAW3222 instance under test */
+const struct device *paw32xx_test_dev(void);
+
+/** @brief The emulator behind paw32xx_test_dev() */
+const struct emul *paw32xx_test_emul(void);
+
+/**
+ * @brief Wait until the driver has read all pending motion
+ */
+void paw32xx_test_settle(void);
+
+/**
+ * @brief Return the driver to move mode on layer 0 and clear the capture
+ *
+ * Removes any motion source and storm, lets pending motion drain and
+ * only then clears @ref paw32xx_test_capture.
+ */
+void paw32xx_test_reset(void);
+
+/**
+ * @brief Select a layer and let the driver resolve its mode from it
+ *
+ * @param layer Layer the fake keymap reports as highest active
+ */
+void paw32xx_test_set_layer(uint8_t layer);
+
+#endif /* PAW3222_TEST_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/ztest.h>
+
+#include "paw3222.h"
+#include "paw3222_emul.h"
+#include "paw3222_input.h"
+#include "paw3222_regs.h"
+#include "paw3222_test.h"
+
+static void paw32xx_smoke_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  paw32xx_test_reset();
+}
+
+ZTEST(paw3222_smoke, test_configured) {
+  uint8_t val;
+
+  zassert_true(device_is_ready(paw32xx_test_dev()), "driver not ready");
+
+  zassert_ok(paw32xx_emul_reg_get(paw32xx_test_emul(), PAW32XX_CPI_X, &val));
+  zassert_equal(val, CONFIG_PAW3222_RES_CPI / RES_STEP, "CPI_X is %u", val);
+  zassert_ok(paw32xx_emul_reg_get(paw32xx_test_emul(), PAW32XX_WRITE_PROTECT,
+                                  &val));
+  zassert_equal(val, WRITE_PROTECT_ENABLE, "write protection left off");
+}
+
+ZTEST(paw3222_smoke, test_move) {
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 10, -3);
+  paw32xx_test_settle();
+
+  zassert_equal(paw32xx_test_capture.rel_x, 10);
+  zassert_equal(paw32xx_test_capture.rel_y, -3);
+  zassert_equal(paw32xx_test_capture.syncs, 1, "one sample, one report");
+}
+
+ZTEST(paw3222_smoke, test_motion_after_quiet) {
+  /* The second burst must come in through a fresh motion interrupt */
+  paw32xx_emul_add_motion(paw32xx_test_emul(), -7, 4);
+  paw32xx_test_settle();
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 2, 5);
+  paw32xx_test_settle();
+
+  zassert_equal(paw32xx_test_capture.rel_x, -5);
+  zassert_equal(paw32xx_test_capture.rel_y, 9);
+  zassert_equal(paw32xx_test_capture.syncs, 2);
+}
+
+ZTEST(paw3222_smoke, test_scroll_layer) {
+  paw32xx_test_set_layer(1);
+
+  /* One wheel step per sample that crosses the tick */
+  for (int i = 0; i < 3; i++) {
+    paw32xx_emul_add_motion(paw32xx_test_emul(), 0,
+                            CONFIG_PAW3222_SCROLL_TICK);
+    paw32xx_test_settle();
+  }
+
+  zassert_equal(paw32xx_test_capture.wheel, 3);
+  zassert_equal(paw32xx_test_capture.rel_x, 0);
+  zassert_equal(paw32xx_test_capture.rel_y, 0);
+}
+
+ZTEST(paw3222_smoke, test_mode_change_drops_scroll) {
+  const int16_t half = CONFIG_PAW3222_SCROLL_TICK / 2 + 1;
+
+  /* Half a tick of travel stays in the accumulator */
+  paw32xx_test_set_layer(1);
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 0, half);
+  paw32xx_test_settle();
+  zassert_equal(paw32xx_test_capture.wheel, 0);
+
+  /* A mode switch from another thread than the motion work's */
+  paw32xx_test_set_layer(0);
+  paw32xx_apply_mode(paw32xx_test_dev());
+  paw32xx_test_set_layer(1);
+  paw32xx_apply_mode(paw32xx_test_dev());
+
+  /* Without the leftover the second half does not reach a tick */
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 0, half);
+  paw32xx_test_settle();
+  zassert_equal(paw32xx_test_capture.wheel, 0, "scroll travel survived");
+}
+
+ZTEST(paw3222_smoke, test_reinit) {
+  const int16_t half = CONFIG_PAW3222_SCROLL_TICK / 2 + 1;
+  uint8_t val;
+
+  paw32xx_test_set_layer(1);
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 0, half);
+  paw32xx_test_settle();
+
+  /* Back to the tuned CPI, and the reset lost the scroll travel too */
+  zassert_ok(paw32xx_reinit(paw32xx_test_dev()));
+  zassert_ok(paw32xx_emul_reg_get(paw32xx_test_emul(), PAW32XX_CPI_X, &val));
+  zassert_equal(val, CONFIG_PAW3222_RES_CPI / RES_STEP, "CPI_X is %u", val);
+
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 0, half);
+  paw32xx_test_settle();
+  zassert_equal(paw32xx_test_capture.wheel, 0, "scroll travel survived");
+}
+
+#ifdef CONFIG_PAW3222_SENSOR
+ZTEST(paw3222_smoke, test_sensor_fetch_consumes) {
+  struct sensor_value val;
+
+  paw32xx_emul_add_motion(paw32xx_test_emul(), 10, -3);
+  paw32xx_test_settle();
+
+  zassert_ok(sensor_sample_fetch(paw32xx_test_dev()));
+  zassert_ok(sensor_channel_get(paw32xx_test_dev(), SENSOR_CHAN_POS_DX, &val));
+  zassert_equal(val.val1, 10);
+  zassert_ok(sensor_channel_get(paw32xx_test_dev(), SENSOR_CHAN_POS_DY, &val));
+  zassert_equal(val.val1, -3);
+
+  /* No motion since: the same sample is not counted again */
+  zassert_ok(sensor_sample_fetch(paw32xx_test_dev()));
+  zassert_ok(sensor_channel_get(paw32xx_test_dev(), SENSOR_CHAN_POS_DX, &val));
+  zassert_equal(val.val1, 0);
+  zassert_ok(sensor_channel_get(paw32xx_test_dev(), SENSOR_CHAN_POS_DY, &val));
+  zassert_equal(val.val1, 0);
+}
+#endif
+
+ZTEST_SUITE(paw3222_smoke, NULL, NULL, paw32xx_smoke_before, NULL, NULL);
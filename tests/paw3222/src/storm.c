@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zmk/keymap.h>
+
+#include "paw3222.h"
+#include "paw3222_emul.h"
+#include "paw3222_input.h"
+#include "paw3222_pipeline.h"
+#include "paw3222_test.h"
+
+/* The parameters of "paw3222 storm" */
+#define PAW32XX_STORM_MS 1000
+#define PAW32XX_STORM_DELTA 300
+#define PAW32XX_STORM_IRQ_PERIOD_US 200
+#define PAW32XX_STORM_MODE_PERIOD_MS 1
+
+/** @brief Layers with a mode of their own, see boards/native_sim.overlay */
+#define PAW32XX_STORM_LAYERS (PAW32XX_BOTHSCROLL + 1)
+
+/* Selects the layer in arg, as a layer change followed by a mode key would */
+static int paw32xx_storm_layer(const struct device *dev, void *arg) {
+  zmk_fake_set_layer((uint8_t)(uintptr_t)arg);
+  paw32xx_update_effective_mode(dev);
+  paw32xx_apply_mode(dev);
+  return 0;
+}
+
+static void paw32xx_storm_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  paw32xx_test_reset();
+}
+
+ZTEST(paw3222_storm, test_storm) {
+  const struct device *dev = paw32xx_test_dev();
+  const struct emul *emul = paw32xx_test_emul();
+  const struct paw32xx_data *data = dev->data;
+  const struct paw32xx_emul_storm storm = {
+      .dx = PAW32XX_STORM_DELTA,
+      .dy = -PAW32XX_STORM_DELTA,
+      .irq_period_us = PAW32XX_STORM_IRQ_PERIOD_US,
+  };
+  struct paw32xx_emul_stats before, after;
+  uint32_t switches = 0, edges, overruns = 0;
+  uint32_t samples;
+  int64_t end;
+
+  zassert_ok(paw32xx_stats_reset(dev));
+  paw32xx_emul_get_stats(emul, &before);
+
+  paw32xx_emul_storm_start(emul, &storm);
+  end = k_uptime_get() + PAW32XX_STORM_MS;
+  while (k_uptime_get() < end) {
+    switches++;
+    zassert_ok(paw32xx_queue_call(
+        dev, paw32xx_storm_layer,
+        (void *)(uintptr_t)(switches % PAW32XX_STORM_LAYERS)));
+    k_sleep(K_MSEC(PAW32XX_STORM_MODE_PERIOD_MS));
+  }
+  paw32xx_emul_storm_stop(emul);
+  paw32xx_test_settle();
+  paw32xx_emul_get_stats(emul, &after);
+
+#ifdef CONFIG_PAW3222_PIPELINE
+  uint32_t depth_max, wait_max_us;
+
+  paw32xx_pipeline_get(dev, &overruns, &depth_max, &wait_max_us);
+#endif
+
+  edges = after.irq_edges - before.irq_edges;
+  samples = data->stats.samples;
+  TC_PRINT("storm: %u edges (%u forced), %u irqs, %u work runs, %u samples, "
+           "%u reports, %u overruns, %u mode changes\n",
+           edges, after.storm_pulses - before.storm_pulses, data->stats.irqs,
+           data->stats.work_runs, samples, data->stats.reports, overruns,
+           data->stats.mode_changes);
+
+  /* Nothing may fail or block however hard the line is hammered */
+  zassert_equal(data->stats.spi_errors, 0);
+  zassert_equal(data->stats.report_stalls, 0);
+  zassert_true(after.storm_pulses > before.storm_pulses, "no forced pulses");
+
+  /* Edges may be coalesced, never invented */
+  zassert_true(data->stats.irqs > 0, "motion interrupt never fired");
+  zassert_true(data->stats.irqs <= edges, "%u irqs for %u edges",
+               data->stats.irqs, edges);
+
+  /* Motion never stops, so the driver samples at least once per poll */
+  zassert_true(samples >= PAW32XX_STORM_MS / PAW32XX_POLL_INTERVAL_MS,
+               "only %u samples", samples);
+  zassert_true(data->stats.work_runs >= samples);
+  zassert_true(data->stats.work_delay_max_us <
+                   PAW32XX_POLL_INTERVAL_MS * USEC_PER_MSEC,
+               "work delayed %u us", data->stats.work_delay_max_us);
+
+  /* Saturated deltas emit in every mode: one report per sample, less the
+   * samples a full ring folded into the next */
+  zassert_between_inclusive(data->stats.reports, samples - overruns, samples);
+
+  /* Each flip moves to the next layer's mode, so every one is effective */
+  zassert_equal(data->stats.mode_changes, switches,
+                "%u mode changes for %u flips", data->stats.mode_changes,
+                switches);
+}
+
+ZTEST_SUITE(paw3222_storm, NULL, NULL, paw32xx_storm_before, NULL, NULL);
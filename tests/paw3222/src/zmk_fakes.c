@@ -0,0 +1,18 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/keymap.h>
+
+ZMK_EVENT_IMPL(zmk_layer_state_changed);
+
+static uint8_t zmk_fake_layer;
+
+uint8_t zmk_keymap_highest_layer_active(void) { return zmk_fake_layer; }
+
+void zmk_fake_set_layer(uint8_t layer) { zmk_fake_layer = layer; }
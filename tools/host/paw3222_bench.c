@@ -0,0 +1,307 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-stage microbenchmarks for the motion pipeline.
+ *
+ *   paw3222_bench [-n passes] [-s samples] [--csv]
+ *
+ * Every stage runs over the same buffer of pseudo-random raw register
+ * values; the buffer is walked once per pass. For each stage the fastest
+ * and the mean pass are reported in nanoseconds per sample. The fastest
+ * pass is the number to compare between builds, the mean shows how noisy
+ * the machine was.
+ *
+ * The stages are the public entry points of paw3222_core.h. Snipe division
+ * and scroll accumulation are internal to paw32xx_core_process(), so they
+ * are measured as the process call in the mode that uses them, next to
+ * "process move" as the baseline.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "paw3222_core.h"
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+struct bench_ctx {
+  const uint8_t (*raw)[2];   /* raw DELTA_X / DELTA_Y values */
+  const int16_t (*xy)[2];    /* the same, sign-extended */
+  size_t count;
+  struct paw32xx_core_params params;
+  struct paw32xx_core_state state;
+};
+
+struct bench_stage {
+  const char *name;
+  /* Runs one pass, returns a value that depends on every sample */
+  uint32_t (*pass)(struct bench_ctx *ctx, int arg);
+  int arg;
+};
+
+static const int32_t layers_scroll_hsnipe[] = {9, 10};
+static const int32_t layers_scroll_snipe[] = {7, 8};
+static const int32_t layers_scroll_h[] = {5, 6};
+static const int32_t layers_scroll[] = {3, 4};
+static const int32_t layers_snipe[] = {1, 2};
+static const int32_t layers_bothscroll[] = {11, 12};
+
+/* Same priority order as get_input_mode_for_current_layer() */
+static const struct paw32xx_core_layer_rule layer_rules[] = {
+    {PAW32XX_SCROLL_HORIZONTAL_SNIPE, layers_scroll_hsnipe,
+     ARRAY_LEN(layers_scroll_hsnipe)},
+    {PAW32XX_SCROLL_SNIPE, layers_scroll_snipe, ARRAY_LEN(layers_scroll_snipe)},
+    {PAW32XX_SCROLL_HORIZONTAL, layers_scroll_h, ARRAY_LEN(layers_scroll_h)},
+    {PAW32XX_SCROLL, layers_scroll, ARRAY_LEN(layers_scroll)},
+    {PAW32XX_SNIPE, layers_snipe, ARRAY_LEN(layers_snipe)},
+    {PAW32XX_BOTHSCROLL, layers_bothscroll, ARRAY_LEN(layers_bothscroll)},
+};
+
+static uint32_t pass_sign_extend(struct bench_ctx *ctx, int arg) {
+  uint32_t acc = 0;
+
+  (void)arg;
+  for (size_t i = 0; i < ctx->count; i++) {
+    acc += (uint16_t)paw32xx_core_sign_extend(ctx->raw[i][0]);
+    acc += (uint16_t)paw32xx_core_sign_extend(ctx->raw[i][1]);
+  }
+
+  return acc;
+}
+
+static uint32_t pass_rotation(struct bench_ctx *ctx, int rotation) {
+  uint32_t acc = 0;
+
+  for (size_t i = 0; i < ctx->count; i++) {
+    acc += (uint16_t)paw32xx_core_scroll_y(ctx->xy[i][0], ctx->xy[i][1],
+                                           (uint16_t)rotation);
+  }
+
+  return acc;
+}
+
+static uint32_t pass_behavior_mode(struct bench_ctx *ctx, int arg) {
+  uint32_t acc = 0;
+
+  (void)arg;
+  for (size_t i = 0; i < ctx->count; i++) {
+    acc += paw32xx_core_behavior_mode(ctx->raw[i][0] & 0x0f);
+  }
+
+  return acc;
+}
+
+static uint32_t pass_layer_mode(struct bench_ctx *ctx, int arg) {
+  uint32_t acc = 0;
+
+  (void)arg;
+  for (size_t i = 0; i < ctx->count; i++) {
+    /* Layers 0-15: hits every rule and misses all of them */
+    acc += paw32xx_core_layer_mode(layer_rules, ARRAY_LEN(layer_rules),
+                                   ctx->raw[i][0] & 0x0f);
+  }
+
+  return acc;
+}
+
+static uint32_t pass_process(struct bench_ctx *ctx, int mode) {
+  struct paw32xx_core_out out;
+  uint32_t acc = 0;
+
+  for (size_t i = 0; i < ctx->count; i++) {
+    paw32xx_core_process(&ctx->params, &ctx->state, mode, ctx->xy[i][0],
+                         ctx->xy[i][1], &out);
+    acc += out.count;
+    if (out.count > 0) {
+      acc += (uint16_t)out.ev[0].value;
+    }
+  }
+
+  return acc;
+}
+
+/* Sign extension plus processing, as the driver runs it per sample */
+static uint32_t pass_sample(struct bench_ctx *ctx, int mode) {
+  struct paw32xx_core_out out;
+  uint32_t acc = 0;
+
+  for (size_t i = 0; i < ctx->count; i++) {
+    paw32xx_core_process(&ctx->params, &ctx->state, mode,
+                         paw32xx_core_sign_extend(ctx->raw[i][0]),
+                         paw32xx_core_sign_extend(ctx->raw[i][1]), &out);
+    acc += out.count;
+  }
+
+  return acc;
+}
+
+static const struct bench_stage stages[] = {
+    {"sign_extend", pass_sign_extend, 0},
+    {"rotation 0", pass_rotation, 0},
+    {"rotation 90", pass_rotation, 90},
+    {"rotation 180", pass_rotation, 180},
+    {"rotation 270", pass_rotation, 270},
+    {"mode behavior", pass_behavior_mode, 0},
+    {"mode layer", pass_layer_mode, 0},
+    {"process move", pass_process, PAW32XX_MOVE},
+    {"process snipe", pass_process, PAW32XX_SNIPE},
+    {"process scroll", pass_process, PAW32XX_SCROLL},
+    {"process scroll_h", pass_process, PAW32XX_SCROLL_HORIZONTAL},
+    {"process scroll_snipe", pass_process, PAW32XX_SCROLL_SNIPE},
+    {"process scroll_h_snipe", pass_process, PAW32XX_SCROLL_HORIZONTAL_SNIPE},
+    {"process bothscroll", pass_process, PAW32XX_BOTHSCROLL},
+    {"process bothscroll_snipe", pass_process, PAW32XX_BOTHSCROLL_SNIPE},
+    {"sample move", pass_sample, PAW32XX_MOVE},
+    {"sample bothscroll_snipe", pass_sample, PAW32XX_BOTHSCROLL_SNIPE},
+};
+
+static double now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int parse_long(const char *s, long min, long max, long *out) {
+  char *end;
+  long v;
+
+  errno = 0;
+  v = strtol(s, &end, 0);
+  if (errno != 0 || *end != '\0' || v < min || v > max) {
+    return -EINVAL;
+  }
+
+  *out = v;
+  return 0;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  -n, --passes N    timed passes per stage (200)\n"
+          "  -s, --samples N   samples per pass (4096)\n"
+          "  -c, --csv         print CSV\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  static const struct option long_opts[] = {
+      {"passes", required_argument, NULL, 'n'},
+      {"samples", required_argument, NULL, 's'},
+      {"csv", no_argument, NULL, 'c'},
+      {NULL, 0, NULL, 0},
+  };
+  struct bench_ctx ctx = {
+      .params =
+          {
+              .rotation = 90,
+              .snipe_divisor = 2,
+              .scroll_snipe_divisor = 3,
+              .scroll_tick = 10,
+              .scroll_snipe_tick = 20,
+          },
+  };
+  volatile uint32_t sink = 0;
+  uint8_t(*raw)[2];
+  int16_t(*xy)[2];
+  long passes = 200, count = 4096, v;
+  uint32_t lcg = 0x2545f491;
+  int csv = 0, c;
+
+  while ((c = getopt_long(argc, argv, "n:s:c", long_opts, NULL)) != -1) {
+    switch (c) {
+    case 'n':
+      if (parse_long(optarg, 1, 1000000, &v) < 0) {
+        goto bad_arg;
+      }
+      passes = v;
+      break;
+    case 's':
+      if (parse_long(optarg, 1, 1 << 24, &v) < 0) {
+        goto bad_arg;
+      }
+      count = v;
+      break;
+    case 'c':
+      csv = 1;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (optind != argc) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  raw = malloc((size_t)count * sizeof(*raw));
+  xy = malloc((size_t)count * sizeof(*xy));
+  if (raw == NULL || xy == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+  for (long i = 0; i < count; i++) {
+    lcg = lcg * 1664525u + 1013904223u;
+    raw[i][0] = (uint8_t)(lcg >> 24);
+    raw[i][1] = (uint8_t)(lcg >> 16);
+    xy[i][0] = paw32xx_core_sign_extend(raw[i][0]);
+    xy[i][1] = paw32xx_core_sign_extend(raw[i][1]);
+  }
+  ctx.raw = (const uint8_t(*)[2])raw;
+  ctx.xy = (const int16_t(*)[2])xy;
+  ctx.count = (size_t)count;
+
+  if (csv) {
+    printf("stage,min_ns_per_sample,mean_ns_per_sample\n");
+  } else {
+    printf("%-26s %10s %10s  (ns/sample, %ld x %ld samples)\n", "stage",
+           "min", "mean", passes, count);
+  }
+
+  for (size_t s = 0; s < ARRAY_LEN(stages); s++) {
+    double best = -1, total = 0;
+
+    paw32xx_core_reset(&ctx.state);
+    /* Warm up caches and branch predictors */
+    sink += stages[s].pass(&ctx, stages[s].arg);
+
+    for (long p = 0; p < passes; p++) {
+      double t0 = now_ns();
+      double dt;
+
+      sink += stages[s].pass(&ctx, stages[s].arg);
+      dt = now_ns() - t0;
+      total += dt;
+      if (best < 0 || dt < best) {
+        best = dt;
+      }
+    }
+
+    if (csv) {
+      printf("%s,%.3f,%.3f\n", stages[s].name, best / (double)count,
+             total / ((double)passes * (double)count));
+    } else {
+      printf("%-26s %10.3f %10.3f\n", stages[s].name, best / (double)count,
+             total / ((double)passes * (double)count));
+    }
+  }
+
+  free(raw);
+  free(xy);
+  return 0;
+
+bad_arg:
+  fprintf(stderr, "invalid value for -%c: %s\n", c, optarg);
+  return 2;
+}
@@ -0,0 +1,582 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Trace-driven energy estimate for a driver configuration.
+ *
+ *   paw3222_energy [options] [trace]
+ *
+ * Replays a usage trace against the shared driver model (paw3222_sim.c) in
+ * virtual time, counts MCU wakeups, SPI transfers and bytes, reports and
+ * the time spent in each MCU and sensor power state, and turns the counts
+ * into charge with a per-board current model. The result is an average
+ * current and a projected battery life, so two configurations can be
+ * compared in seconds instead of with a multi-day field test.
+ *
+ * The result is a model-only estimate: nothing here runs the driver or
+ * the sensor emulator, and neither the model's timings (paw3222_sim.h)
+ * nor the default currents are measured. The output says so and names the
+ * current model keys that still hold a placeholder.
+ *
+ * The trace is text, one step per line, '#' starts a comment:
+ *
+ *   move <ms>     motion on the sensor
+ *   pause <ms>    no motion
+ *   idle <s>      no motion, in seconds
+ *   repeat <n>    repeat the steps up to the matching "end"
+ *   end
+ *
+ * Without a trace a built-in office day is replayed (see default_trace).
+ *
+ * The board model is a text file of "<key> <value>" lines, keys as in
+ * model_keys[]; keys that are not given keep the defaults. The defaults
+ * are placeholders, round numbers for an nRF52-class MCU with a PAW3222
+ * that are only meant as a starting point: measure the board and put the figures in a
+ * model file before trusting the absolute battery life. The differences
+ * between two configurations on the same model are the useful part.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "paw3222_sim.h"
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX_DEPTH 8
+#define MAX_BURSTS 10000000
+
+/* One office day: 8 working hours, then evening and night */
+static const char default_trace[] =
+    "repeat 8\n"
+    "  repeat 3\n"
+    "    # typing: the hand brushes the ball now and then\n"
+    "    repeat 12\n"
+    "      pause 45000\n"
+    "      move 60\n"
+    "    end\n"
+    "    # trackball session: move, aim, click\n"
+    "    repeat 30\n"
+    "      move 700\n"
+    "      pause 400\n"
+    "    end\n"
+    "    # reading\n"
+    "    pause 626280\n"
+    "  end\n"
+    "end\n"
+    "idle 57600\n";
+
+struct energy_model {
+  double battery_mah;
+  double base_ua;         /* rest of the board, radio link upkeep */
+  double mcu_sleep_ua;    /* MCU idle, RTC running */
+  double mcu_active_ua;   /* MCU running */
+  double mcu_wakeup_uc;   /* clock start-up and the like per wakeup */
+  double spi_xfer_nc;     /* SPI set-up per transfer */
+  double spi_byte_nc;     /* per byte on the bus */
+  double report_uc;       /* radio cost of one input report */
+  double sensor_run_ua;   /* sensor tracking motion */
+  double sensor_rest_ua;  /* sensor awake, no motion (its own rest modes) */
+  double sensor_sleep_ua; /* sensor in the sleep mode set_sleep() requests */
+};
+
+static const struct {
+  const char *name;
+  size_t offset;
+} model_keys[] = {
+    {"battery_mah", offsetof(struct energy_model, battery_mah)},
+    {"base_ua", offsetof(struct energy_model, base_ua)},
+    {"mcu_sleep_ua", offsetof(struct energy_model, mcu_sleep_ua)},
+    {"mcu_active_ua", offsetof(struct energy_model, mcu_active_ua)},
+    {"mcu_wakeup_uc", offsetof(struct energy_model, mcu_wakeup_uc)},
+    {"spi_xfer_nc", offsetof(struct energy_model, spi_xfer_nc)},
+    {"spi_byte_nc", offsetof(struct energy_model, spi_byte_nc)},
+    {"report_uc", offsetof(struct energy_model, report_uc)},
+    {"sensor_run_ua", offsetof(struct energy_model, sensor_run_ua)},
+    {"sensor_rest_ua", offsetof(struct energy_model, sensor_rest_ua)},
+    {"sensor_sleep_ua", offsetof(struct energy_model, sensor_sleep_ua)},
+};
+
+enum trace_op { OP_MOVE, OP_PAUSE, OP_REPEAT, OP_END };
+
+struct trace_step {
+  enum trace_op op;
+  uint64_t arg; /* duration in µs, or repeat count */
+  int match;    /* OP_REPEAT: index of its OP_END */
+};
+
+struct trace {
+  struct trace_step *steps;
+  int count;
+  struct sim_burst *bursts;
+  size_t burst_count, burst_cap;
+  uint64_t t;
+};
+
+static char *load_text(const char *path) {
+  FILE *f = fopen(path, "r");
+  char *buf = NULL;
+  size_t cap = 0, n = 0;
+  int c;
+
+  if (f == NULL) {
+    perror(path);
+    return NULL;
+  }
+  while ((c = fgetc(f)) != EOF) {
+    if (n + 1 >= cap) {
+      cap = cap ? 2 * cap : 4096;
+      buf = realloc(buf, cap);
+      if (buf == NULL) {
+        fclose(f);
+        return NULL;
+      }
+    }
+    buf[n++] = (char)c;
+  }
+  fclose(f);
+  if (buf == NULL) {
+    buf = calloc(1, 1);
+  } else {
+    buf[n] = '\0';
+  }
+  return buf;
+}
+
+/* Splits off the next line, with its comment removed; NULL at the end */
+static char *next_line(char **pos) {
+  char *line = *pos, *p;
+
+  if (*line == '\0') {
+    return NULL;
+  }
+  p = strchr(line, '\n');
+  if (p != NULL) {
+    *p = '\0';
+    *pos = p + 1;
+  } else {
+    *pos = line + strlen(line);
+  }
+  p = strchr(line, '#');
+  if (p != NULL) {
+    *p = '\0';
+  }
+  return line;
+}
+
+static int parse_u64(const char *s, uint64_t max, uint64_t *out) {
+  char *end;
+  unsigned long long v;
+
+  if (s == NULL || !isdigit((unsigned char)*s)) {
+    return -EINVAL;
+  }
+  errno = 0;
+  v = strtoull(s, &end, 10);
+  if (errno != 0 || *end != '\0' || v > max) {
+    return -EINVAL;
+  }
+  *out = v;
+  return 0;
+}
+
+static int parse_trace(char *text, struct trace *tr) {
+  int stack[MAX_DEPTH], depth = 0, cap = 0, lineno = 0;
+  char *pos = text, *line;
+
+  while ((line = next_line(&pos)) != NULL) {
+    char *word = strtok(line, " \t\r");
+    char *arg = strtok(NULL, " \t\r");
+    struct trace_step st = {0};
+    uint64_t v = 0;
+
+    lineno++;
+    if (word == NULL) {
+      continue;
+    }
+    if (strcmp(word, "end") == 0) {
+      if (depth == 0 || arg != NULL) {
+        goto bad_line;
+      }
+      st.op = OP_END;
+      tr->steps[stack[--depth]].match = tr->count;
+    } else {
+      if (parse_u64(arg, UINT32_MAX, &v) < 0 || strtok(NULL, " \t\r")) {
+        goto bad_line;
+      }
+      if (strcmp(word, "move") == 0) {
+        st.op = OP_MOVE;
+        st.arg = v * 1000;
+      } else if (strcmp(word, "pause") == 0) {
+        st.op = OP_PAUSE;
+        st.arg = v * 1000;
+      } else if (strcmp(word, "idle") == 0) {
+        st.op = OP_PAUSE;
+        st.arg = v * 1000000;
+      } else if (strcmp(word, "repeat") == 0) {
+        if (depth == MAX_DEPTH) {
+          goto bad_line;
+        }
+        st.op = OP_REPEAT;
+        st.arg = v;
+      } else {
+        goto bad_line;
+      }
+    }
+
+    if (tr->count == cap) {
+      cap = cap ? 2 * cap : 64;
+      tr->steps = realloc(tr->steps, (size_t)cap * sizeof(*tr->steps));
+      if (tr->steps == NULL) {
+        return -ENOMEM;
+      }
+    }
+    if (st.op == OP_REPEAT) {
+      stack[depth++] = tr->count;
+    }
+    tr->steps[tr->count++] = st;
+  }
+  if (depth != 0) {
+    fprintf(stderr, "trace: missing \"end\"\n");
+    return -EINVAL;
+  }
+  return 0;
+
+bad_line:
+  fprintf(stderr, "trace: line %d: invalid step\n", lineno);
+  return -EINVAL;
+}
+
+static int add_motion(struct trace *tr, uint64_t duration) {
+  struct sim_burst *last =
+      tr->burst_count > 0 ? &tr->bursts[tr->burst_count - 1] : NULL;
+
+  if (last != NULL && last->end == tr->t) {
+    last->end += duration;
+  } else {
+    if (tr->burst_count == tr->burst_cap) {
+      if (tr->burst_cap >= MAX_BURSTS) {
+        fprintf(stderr, "trace: more than %d bursts\n", MAX_BURSTS);
+        return -E2BIG;
+      }
+      tr->burst_cap = tr->burst_cap ? 2 * tr->burst_cap : 1024;
+      tr->bursts = realloc(tr->bursts, tr->burst_cap * sizeof(*tr->bursts));
+      if (tr->bursts == NULL) {
+        return -ENOMEM;
+      }
+    }
+    tr->bursts[tr->burst_count].start = tr->t;
+    tr->bursts[tr->burst_count].end = tr->t + duration;
+    tr->burst_count++;
+  }
+  tr->t += duration;
+  return 0;
+}
+
+/* Appends the steps from..to-1 to the timeline */
+static int expand(struct trace *tr, int from, int to) {
+  for (int i = from; i < to; i++) {
+    const struct trace_step *st = &tr->steps[i];
+    int ret;
+
+    switch (st->op) {
+    case OP_MOVE:
+      if (st->arg > 0 && (ret = add_motion(tr, st->arg)) < 0) {
+        return ret;
+      }
+      break;
+    case OP_PAUSE:
+      tr->t += st->arg;
+      break;
+    case OP_REPEAT:
+      for (uint64_t k = 0; k < st->arg; k++) {
+        ret = expand(tr, i + 1, st->match);
+        if (ret < 0) {
+          return ret;
+        }
+      }
+      i = st->match;
+      break;
+    case OP_END:
+      break;
+    }
+  }
+  return 0;
+}
+
+/* Sets bit k of *given for every model_keys[k] the file sets */
+static int load_model(const char *path, struct energy_model *m,
+                      uint32_t *given) {
+  char *text = load_text(path), *pos = text, *line;
+  int lineno = 0, ret = 0;
+
+  if (text == NULL) {
+    return -EIO;
+  }
+  while ((line = next_line(&pos)) != NULL) {
+    char *key = strtok(line, " \t\r=");
+    char *val = strtok(NULL, " \t\r=");
+    char *end;
+    size_t k;
+    double v;
+
+    lineno++;
+    if (key == NULL) {
+      continue;
+    }
+    for (k = 0; k < ARRAY_LEN(model_keys); k++) {
+      if (strcmp(key, model_keys[k].name) == 0) {
+        break;
+      }
+    }
+    v = val != NULL ? strtod(val, &end) : -1;
+    if (k == ARRAY_LEN(model_keys) || val == NULL || *end != '\0' || v < 0) {
+      fprintf(stderr, "%s: line %d: invalid entry\n", path, lineno);
+      ret = -EINVAL;
+      break;
+    }
+    *(double *)((char *)m + model_keys[k].offset) = v;
+    *given |= 1U << k;
+  }
+  free(text);
+  return ret;
+}
+
+static int parse_long(const char *s, long min, long max, long *out) {
+  char *end;
+  long v;
+
+  errno = 0;
+  v = strtol(s, &end, 0);
+  if (errno != 0 || *end != '\0' || v < min || v > max) {
+    return -EINVAL;
+  }
+
+  *out = v;
+  return 0;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [options] [trace]\n"
+          "  -t, --timeout S        idle timeout in seconds (300)\n"
+          "  -p, --poll MS          motion polling interval (15)\n"
+          "  -r, --reduced-scan MS  enable reduced scan with this interval\n"
+          "  -n, --no-power-ctrl    never put the sensor to sleep\n"
+          "  -l, --latency US       work queue latency (50)\n"
+          "  -m, --model FILE       board current model (placeholder defaults)\n"
+          "  -c, --csv              print CSV\n",
+          prog);
+}
+
+static void put(int csv, const char *key, double v, const char *unit) {
+  if (csv) {
+    printf("%s,%.6g\n", key, v);
+  } else {
+    printf("%-22s %14.3f %s\n", key, v, unit);
+  }
+}
+
+int main(int argc, char **argv) {
+  static const struct option long_opts[] = {
+      {"timeout", required_argument, NULL, 't'},
+      {"poll", required_argument, NULL, 'p'},
+      {"reduced-scan", required_argument, NULL, 'r'},
+      {"no-power-ctrl", no_argument, NULL, 'n'},
+      {"latency", required_argument, NULL, 'l'},
+      {"model", required_argument, NULL, 'm'},
+      {"csv", no_argument, NULL, 'c'},
+      {NULL, 0, NULL, 0},
+  };
+  struct sim_cfg cfg = {
+      .timeout_us = 300ULL * 1000000,
+      .poll_us = 15000,
+      .reduced_us = 100000,
+      .latency_us = 50,
+  };
+  /* Placeholders, not measurements; see the file comment */
+  struct energy_model m = {
+      .battery_mah = 110,
+      .base_ua = 20,
+      .mcu_sleep_ua = 3,
+      .mcu_active_ua = 3000,
+      .mcu_wakeup_uc = 0.2,
+      .spi_xfer_nc = 20,
+      .spi_byte_nc = 1,
+      .report_uc = 8,
+      .sensor_run_ua = 1500,
+      .sensor_rest_ua = 300,
+      .sensor_sleep_ua = 15,
+  };
+  struct trace tr = {0};
+  const struct sim_counters *n;
+  double secs, active_s, run_s, sleep_s, rest_s;
+  double q_mcu, q_spi, q_radio, q_sensor, q_base, q_total, avg_ua;
+  const char *model_path = NULL;
+  uint32_t given = 0;
+  unsigned int placeholders = 0;
+  struct sim *s;
+  char *text;
+  long val;
+  int csv = 0, c, ret;
+
+  while ((c = getopt_long(argc, argv, "t:p:r:nl:m:c", long_opts, NULL)) !=
+         -1) {
+    switch (c) {
+    case 't':
+      if (parse_long(optarg, 1, 86400, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.timeout_us = (uint64_t)val * 1000000;
+      break;
+    case 'p':
+      if (parse_long(optarg, 1, 1000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.poll_us = (uint64_t)val * 1000;
+      break;
+    case 'r':
+      if (parse_long(optarg, 1, 10000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.reduced_scan = true;
+      cfg.reduced_us = (uint64_t)val * 1000;
+      break;
+    case 'n':
+      cfg.no_sleep = true;
+      break;
+    case 'l':
+      if (parse_long(optarg, 0, 100000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.latency_us = (uint64_t)val;
+      break;
+    case 'm':
+      model_path = optarg;
+      break;
+    case 'c':
+      csv = 1;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind > 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  if (model_path != NULL && load_model(model_path, &m, &given) < 0) {
+    return 1;
+  }
+  for (size_t k = 0; k < ARRAY_LEN(model_keys); k++) {
+    placeholders += (given & (1U << k)) == 0;
+  }
+  text = optind < argc ? load_text(argv[optind]) : strdup(default_trace);
+  if (text == NULL) {
+    return 1;
+  }
+  ret = parse_trace(text, &tr);
+  free(text);
+  if (ret == 0) {
+    ret = expand(&tr, 0, tr.count);
+  }
+  if (ret < 0 || tr.t == 0) {
+    if (ret == 0) {
+      fprintf(stderr, "trace: empty\n");
+    }
+    return 1;
+  }
+
+  s = malloc(sizeof(*s));
+  if (s == NULL) {
+    return 1;
+  }
+  sim_init(s, &cfg, tr.bursts, (int)tr.burst_count);
+  sim_run(s, tr.t);
+  n = &s->cnt;
+
+  secs = (double)tr.t / 1e6;
+  active_s = (double)n->mcu_active_us / 1e6;
+  run_s = (double)n->sensor_run_us / 1e6;
+  sleep_s = (double)n->sensor_sleep_us / 1e6;
+  rest_s = secs - run_s - sleep_s;
+
+  /* Charge in µC */
+  q_mcu = active_s * m.mcu_active_ua + (secs - active_s) * m.mcu_sleep_ua +
+          n->mcu_wakeups * m.mcu_wakeup_uc;
+  q_spi = (n->spi_xfers * m.spi_xfer_nc + (double)n->spi_bytes * m.spi_byte_nc) /
+          1000;
+  q_radio = n->reports * m.report_uc;
+  q_sensor = run_s * m.sensor_run_ua + rest_s * m.sensor_rest_ua +
+             sleep_s * m.sensor_sleep_ua;
+  q_base = secs * m.base_ua;
+  q_total = q_mcu + q_spi + q_radio + q_sensor + q_base;
+  avg_ua = q_total / secs;
+
+  if (csv) {
+    printf("key,value\n");
+  } else {
+    printf("# model-only estimate: counts from the driver model, charge from "
+           "the current model;\n"
+           "# neither is measured on hardware\n");
+    printf("# current model %s, placeholder values:",
+           model_path != NULL ? model_path : "(built-in)");
+    for (size_t k = 0; k < ARRAY_LEN(model_keys); k++) {
+      if ((given & (1U << k)) == 0) {
+        printf(" %s", model_keys[k].name);
+      }
+    }
+    printf("%s\n", placeholders == 0 ? " none" : "");
+    printf("# trace %s: %.0f s, %zu bursts\n",
+           optind < argc ? argv[optind] : "(built-in office day)", secs,
+           tr.burst_count);
+    printf("# timeout %llu s, poll %llu ms, reduced scan %s, power ctrl %s, "
+           "work latency %llu us\n",
+           (unsigned long long)(cfg.timeout_us / 1000000),
+           (unsigned long long)(cfg.poll_us / 1000),
+           cfg.reduced_scan ? "on" : "off", cfg.no_sleep ? "off" : "on",
+           (unsigned long long)cfg.latency_us);
+  }
+  put(csv, "placeholder_values", placeholders, "");
+  put(csv, "duration", secs, "s");
+  put(csv, "mcu_wakeups", n->mcu_wakeups, "");
+  put(csv, "motion_irqs", n->irqs, "");
+  put(csv, "timer_irqs", n->timer_irqs, "");
+  put(csv, "work_items", n->work_items, "");
+  put(csv, "spi_xfers", n->spi_xfers, "");
+  put(csv, "spi_bytes", (double)n->spi_bytes, "");
+  put(csv, "reports", n->reports, "");
+  put(csv, "sensor_sleeps", s->sleep_count, "");
+  put(csv, "mcu_active", active_s, "s");
+  put(csv, "mcu_sleep", secs - active_s, "s");
+  put(csv, "sensor_run", run_s, "s");
+  put(csv, "sensor_rest", rest_s, "s");
+  put(csv, "sensor_sleep", sleep_s, "s");
+  put(csv, "charge_mcu", q_mcu / 3600, "uAh");
+  put(csv, "charge_spi", q_spi / 3600, "uAh");
+  put(csv, "charge_radio", q_radio / 3600, "uAh");
+  put(csv, "charge_sensor", q_sensor / 3600, "uAh");
+  put(csv, "charge_base", q_base / 3600, "uAh");
+  put(csv, "average_current", avg_ua, "uA");
+  put(csv, "battery_life", m.battery_mah * 1000 / avg_ua / 24, "days");
+
+  ret = s->violations > 0 ? 1 : 0;
+  free(s);
+  free(tr.bursts);
+  free(tr.steps);
+  return ret;
+
+bad_arg:
+  fprintf(stderr, "invalid value for -%c: %s\n", c, optarg);
+  return 2;
+}
@@ -0,0 +1,353 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Virtual-time conformance scenarios for the idle / power state machine.
+ *
+ *   paw3222_idle_sim [-t timeout_s] [-p poll_ms] [-r reduced_ms] [-v]
+ *
+ * Runs the shared driver model (paw3222_sim.c) through scenarios around
+ * idle entry and wake. On top of the model's own checks every scenario
+ * verifies that pending motion is always read within the wake bound (one
+ * sleep frame, one poll interval and the work queue latency) and, for the
+ * single-run scenarios, that set_sleep() calls alternate starting with
+ * sleep. After a wake the first poll must come one reduced-scan interval
+ * (or, without reduced scan, one poll interval) after the wake's sample.
+ * The last scenario holds the motion line stuck asserted.
+ *
+ * One summary line per scenario goes to stdout, the set_sleep() sequence
+ * of the single-run scenarios too; -v adds an event trace. The exit status
+ * is 1 if any scenario violated an invariant.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "paw3222_sim.h"
+
+static void finish(struct sim *s, const char *name, uint32_t runs,
+                   uint32_t *total_violations) {
+  if (s->max_wake_us > sim_wake_bound(s->cfg)) {
+    sim_violation(s, "motion read later than the wake bound");
+  }
+  printf("%-22s %6u %7d %6d %12llu %10u\n", name, runs, s->sleep_count,
+         s->wake_count, (unsigned long long)s->max_wake_us, s->violations);
+  *total_violations += s->violations;
+}
+
+/* set_sleep() calls of a single run must alternate, starting with sleep */
+static void check_sleep_log(struct sim *s) {
+  int n = s->sleep_count + s->wake_count;
+
+  for (int i = 0; i < n && i < SIM_MAX_SLEEP_LOG; i++) {
+    if (s->sleep_log[i] != ((i % 2 == 0) ? 'S' : 'W')) {
+      sim_violation(s, "set_sleep sequence does not alternate");
+      break;
+    }
+  }
+}
+
+static void print_sleep_log(const struct sim *s) {
+  int n = s->sleep_count + s->wake_count;
+
+  printf("  set_sleep:");
+  for (int i = 0; i < n && i < SIM_MAX_SLEEP_LOG; i++) {
+    printf(" %s@%.6f", s->sleep_log[i] == 'S' ? "true" : "false",
+           (double)s->sleep_log_t[i] / 1e6);
+  }
+  printf("%s\n", n == 0 ? " (none)" : "");
+}
+
+static uint32_t scenario_idle_entry(const struct sim_cfg *cfg) {
+  const struct sim_burst b[] = {{0, 50000}};
+  uint32_t v = 0;
+  struct sim s;
+
+  sim_init(&s, cfg, b, 1);
+  sim_run(&s, 2 * cfg->timeout_us);
+  if (s.sleep_count != 1) {
+    sim_violation(&s, "expected exactly one idle entry");
+  } else if (s.sleep_log_t[0] !=
+             s.last_sample + SIM_PROCESS_US + cfg->timeout_us + cfg->latency_us) {
+    sim_violation(&s, "idle entry not one timeout after the last sample");
+  }
+  check_sleep_log(&s);
+  finish(&s, "idle_entry", 1, &v);
+  print_sleep_log(&s);
+  return v;
+}
+
+static uint32_t scenario_wake(const struct sim_cfg *cfg, const char *name) {
+  const uint64_t t2 = cfg->timeout_us + 10000000;
+  const struct sim_burst b[] = {{0, 50000}, {t2, t2 + 50000}};
+  const uint64_t interval = cfg->reduced_scan ? cfg->reduced_us : cfg->poll_us;
+  uint32_t v = 0;
+  uint64_t first_read;
+  struct sim s;
+
+  sim_init(&s, cfg, b, 2);
+  sim_run(&s, t2 - 1);
+  if (!s.sm.idle) {
+    sim_violation(&s, "not idle before the second burst");
+  }
+  sim_run(&s, 2 * t2);
+  first_read = s.sleep_count + s.wake_count >= 2 ? s.sleep_log_t[1] : SIM_NEVER;
+  if (s.wake_count != 1 || first_read == SIM_NEVER || first_read < t2) {
+    sim_violation(&s, "expected one wake after the second burst");
+  }
+  if (s.wake_sample == SIM_NEVER || s.first_poll == SIM_NEVER) {
+    sim_violation(&s, "no poll after the wake");
+  } else if (s.first_poll - s.wake_sample != interval) {
+    printf("  first poll %llu us after the wake sample, expected %llu us\n",
+           (unsigned long long)(s.first_poll - s.wake_sample),
+           (unsigned long long)interval);
+    sim_violation(&s, "first poll after the wake at the wrong interval");
+  }
+  check_sleep_log(&s);
+  finish(&s, name, 1, &v);
+  print_sleep_log(&s);
+  return v;
+}
+
+/* Poll cadence after a wake, with and without reduced scan */
+static uint32_t scenario_cadence(const struct sim_cfg *base) {
+  struct sim_cfg cfg = *base;
+  uint32_t v = 0;
+
+  cfg.reduced_scan = true;
+  v += scenario_wake(&cfg, "wake_reduced_scan");
+  return v;
+}
+
+/*
+ * Second burst starting around the idle timeout, in 10 us steps, for
+ * several work queue latencies: the timeout work and the motion edge race
+ * in every possible order, including an edge while the motion work that
+ * the timeout might have cancelled is still queued.
+ */
+static uint32_t scenario_race(const struct sim_cfg *base) {
+  static const uint64_t latencies[] = {0, 50, 500, 3000};
+  uint32_t v = 0, runs = 0;
+  struct sim agg;
+
+  memset(&agg, 0, sizeof(agg));
+  agg.cfg = base;
+  for (size_t l = 0; l < sizeof(latencies) / sizeof(latencies[0]); l++) {
+    struct sim_cfg cfg = *base;
+
+    cfg.latency_us = latencies[l];
+    cfg.verbose = 0;
+    const struct sim_burst first[] = {{0, 20000}};
+    uint64_t t_idle;
+    struct sim probe;
+
+    /* When idle is entered after the first burst alone */
+    sim_init(&probe, &cfg, first, 1);
+    sim_run(&probe, 2 * cfg.timeout_us);
+    t_idle = probe.sleep_log_t[0];
+
+    for (int64_t off = -5000; off <= 5000; off += 10) {
+      uint64_t t2 = (uint64_t)((int64_t)t_idle + off);
+      const struct sim_burst b[] = {{0, 20000}, {t2, t2 + 3000}};
+      struct sim s;
+
+      sim_init(&s, &cfg, b, 2);
+      sim_run(&s, t2 + cfg.timeout_us / 2);
+      if (s.line_since != SIM_NEVER) {
+        sim_violation(&s, "motion left unread");
+      }
+      if (s.violations > 0) {
+        printf("  (latency %llu us, burst at timeout %+lld us)\n",
+               (unsigned long long)cfg.latency_us, (long long)off);
+      }
+      agg.violations += s.violations;
+      agg.sleep_count += s.sleep_count;
+      agg.wake_count += s.wake_count;
+      if (s.max_wake_us > agg.max_wake_us) {
+        agg.max_wake_us = s.max_wake_us;
+      }
+      runs++;
+    }
+  }
+  finish(&agg, "race_timeout_motion", runs, &v);
+  return v;
+}
+
+/* Short taps separated by just under and just over the timeout */
+static uint32_t scenario_taps(const struct sim_cfg *cfg) {
+  const uint64_t t = cfg->timeout_us;
+  const struct sim_burst b[] = {
+      {0, 2000},
+      {t - 1000, t + 1000},
+      {3 * t, 3 * t + 2000},
+      {4 * t + 2000, 4 * t + 2500},
+  };
+  uint32_t v = 0;
+  struct sim s;
+
+  sim_init(&s, cfg, b, 4);
+  sim_run(&s, 6 * t);
+  if (s.line_since != SIM_NEVER) {
+    sim_violation(&s, "motion left unread");
+  }
+  check_sleep_log(&s);
+  finish(&s, "taps_near_timeout", 1, &v);
+  print_sleep_log(&s);
+  return v;
+}
+
+/*
+ * Motion line stuck asserted from 1 s until well into idle, with motion
+ * while faulted awake, while faulted idle and after the line is released:
+ * one fault, fallback polling that still reads every burst, probes instead
+ * of idle transitions, and a single clear back to interrupts.
+ */
+static uint32_t scenario_stuck(const struct sim_cfg *base) {
+  struct sim_cfg cfg = *base;
+  const uint64_t t = cfg.timeout_us;
+  const struct sim_burst b[] = {
+      {0, 50000},
+      {50000000, 50050000},
+      {t + 100000000, t + 100050000},
+      {t + 200000000, t + 200050000},
+  };
+  uint32_t v = 0;
+  struct sim s;
+
+  cfg.stuck.start = 1000000;
+  cfg.stuck.end = t + 150000000;
+  sim_init(&s, &cfg, b, 4);
+  sim_run(&s, t + 250000000);
+  if (s.faults != 1 || s.clears != 1) {
+    sim_violation(&s, "expected exactly one fault and one clear");
+  }
+  if (s.probes == 0) {
+    sim_violation(&s, "no fallback probes while idle");
+  }
+  if (s.sm.fault || s.poll_at != SIM_NEVER) {
+    sim_violation(&s, "still polling after the line was released");
+  }
+  if (s.motion_since != SIM_NEVER) {
+    sim_violation(&s, "motion left unread");
+  }
+  check_sleep_log(&s);
+  finish(&s, "stuck_line", 1, &v);
+  print_sleep_log(&s);
+  printf("  line: %u fault, %u clear, %u probes, %u mcu wakeups\n", s.faults,
+         s.clears, s.probes, s.cnt.mcu_wakeups);
+  return v;
+}
+
+static int parse_long(const char *str, long min, long max, long *out) {
+  char *end;
+  long val;
+
+  errno = 0;
+  val = strtol(str, &end, 0);
+  if (errno != 0 || *end != '\0' || val < min || val > max) {
+    return -EINVAL;
+  }
+
+  *out = val;
+  return 0;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  -t, --timeout S       idle timeout in seconds (300)\n"
+          "  -p, --poll MS         motion polling interval (15)\n"
+          "  -r, --reduced MS      reduced-scan interval (100)\n"
+          "  -l, --latency US      work queue latency (50)\n"
+          "  -v, --verbose         event trace of the single-run scenarios\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  static const struct option long_opts[] = {
+      {"timeout", required_argument, NULL, 't'},
+      {"poll", required_argument, NULL, 'p'},
+      {"reduced", required_argument, NULL, 'r'},
+      {"latency", required_argument, NULL, 'l'},
+      {"verbose", no_argument, NULL, 'v'},
+      {NULL, 0, NULL, 0},
+  };
+  struct sim_cfg cfg = {
+      .timeout_us = 300ULL * 1000000,
+      .poll_us = 15000,
+      .reduced_us = 100000,
+      .latency_us = 50,
+  };
+  uint32_t v = 0;
+  long val;
+  int c;
+
+  while ((c = getopt_long(argc, argv, "t:p:r:l:v", long_opts, NULL)) != -1) {
+    switch (c) {
+    case 't':
+      if (parse_long(optarg, 1, 86400, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.timeout_us = (uint64_t)val * 1000000;
+      break;
+    case 'p':
+      if (parse_long(optarg, 1, 1000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.poll_us = (uint64_t)val * 1000;
+      break;
+    case 'r':
+      if (parse_long(optarg, 1, 10000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.reduced_us = (uint64_t)val * 1000;
+      break;
+    case 'l':
+      if (parse_long(optarg, 0, 100000, &val) < 0) {
+        goto bad_arg;
+      }
+      cfg.latency_us = (uint64_t)val;
+      break;
+    case 'v':
+      cfg.verbose = 1;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (optind != argc) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  printf("# timeout %llu s, poll %llu ms, reduced scan %llu ms, "
+         "work latency %llu us, wake bound %llu us\n",
+         (unsigned long long)(cfg.timeout_us / 1000000),
+         (unsigned long long)(cfg.poll_us / 1000),
+         (unsigned long long)(cfg.reduced_us / 1000),
+         (unsigned long long)cfg.latency_us,
+         (unsigned long long)sim_wake_bound(&cfg));
+  printf("# scenario               runs  sleeps  wakes  max_wake_us "
+         "violations\n");
+
+  v += scenario_idle_entry(&cfg);
+  v += scenario_wake(&cfg, "wake_on_irq");
+  v += scenario_cadence(&cfg);
+  v += scenario_race(&cfg);
+  v += scenario_taps(&cfg);
+  v += scenario_stuck(&cfg);
+
+  return v > 0 ? 1 : 0;
+
+bad_arg:
+  fprintf(stderr, "invalid value for -%c: %s\n", c, optarg);
+  return 2;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Run a fixed, deterministic motion sequence through the motion pipeline
+ * for every input mode, rotation, snipe divisor and scroll tick in the
+ * matrix below and print the resulting event streams.
+ *
+ *   paw3222_matrix            one line per combination with an event count
+ *                             and a 64-bit FNV-1a digest of the stream
+ *   paw3222_matrix --full     the complete event streams
+ *
+ * Output from a known-good build is the reference for changes that must
+ * keep the pipeline output bit-identical:
+ *
+ *   paw3222_matrix > before.txt   (baseline build)
+ *   paw3222_matrix | diff before.txt -
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "paw3222_core.h"
+
+#define SAMPLE_COUNT 512
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+static const uint16_t rotations[] = {0, 90, 180, 270};
+static const uint8_t snipe_divisors[] = {1, 2, 3, 7};
+static const uint8_t scroll_snipe_divisors[] = {1, 3, 5};
+static const uint8_t scroll_ticks[] = {1, 10, 255};
+static const uint8_t scroll_snipe_ticks[] = {1, 20};
+
+/* Boundary values, including ones the 8-bit sensor cannot produce */
+static const int16_t edges[][2] = {
+    {0, 0},         {1, -1},       {-1, 1},       {127, -128},
+    {-128, 127},    {INT16_MAX, 0}, {0, INT16_MAX}, {INT16_MIN, 0},
+    {0, INT16_MIN}, {INT16_MIN, INT16_MIN}, {INT16_MAX, INT16_MAX},
+};
+
+static int16_t samples[SAMPLE_COUNT][2];
+
+/*
+ * Edges first, then runs of steady motion in one direction (which drive
+ * the scroll accumulators across several ticks and into saturation) mixed
+ * with pseudo-random 8-bit deltas from a fixed LCG.
+ */
+static void make_samples(void) {
+  uint32_t lcg = 0x2545f491;
+  size_t n = 0;
+
+  for (; n < ARRAY_LEN(edges); n++) {
+    samples[n][0] = edges[n][0];
+    samples[n][1] = edges[n][1];
+  }
+
+  for (; n < SAMPLE_COUNT; n++) {
+    lcg = lcg * 1664525u + 1013904223u;
+    if ((n / 64) % 2 == 0) {
+      samples[n][0] = (int16_t)((n / 128) % 2 ? -3 : 5);
+      samples[n][1] = (int16_t)((n / 128) % 2 ? 7 : -2);
+    } else {
+      samples[n][0] = (int8_t)(lcg >> 24);
+      samples[n][1] = (int8_t)(lcg >> 16);
+    }
+  }
+
+  /* A long run pins both accumulators at the clamp limits */
+  for (size_t i = SAMPLE_COUNT - 32; i < SAMPLE_COUNT; i++) {
+    samples[i][0] = INT16_MAX;
+    samples[i][1] = INT16_MIN;
+  }
+}
+
+static uint64_t fnv1a(uint64_t h, const void *buf, size_t len) {
+  const uint8_t *p = buf;
+
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 0x100000001b3ULL;
+  }
+
+  return h;
+}
+
+static void run(const struct paw32xx_core_params *params,
+                enum paw32xx_input_mode mode, int full) {
+  struct paw32xx_core_state state;
+  struct paw32xx_core_out out;
+  uint64_t digest = 0xcbf29ce484222325ULL;
+  unsigned long events = 0, clamped = 0;
+
+  paw32xx_core_reset(&state);
+
+  if (full) {
+    printf("# mode=%d rotation=%u snipe_divisor=%u scroll_snipe_divisor=%u "
+           "scroll_tick=%u scroll_snipe_tick=%u\n",
+           mode, params->rotation, params->snipe_divisor,
+           params->scroll_snipe_divisor, params->scroll_tick,
+           params->scroll_snipe_tick);
+  }
+
+  for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+    paw32xx_core_process(params, &state, mode, samples[i][0], samples[i][1],
+                         &out);
+    clamped += out.clamped;
+    for (uint8_t e = 0; e < out.count; e++) {
+      uint8_t rec[4] = {
+          out.ev[e].code,
+          out.ev[e].sync,
+          (uint8_t)((uint16_t)out.ev[e].value & 0xff),
+          (uint8_t)((uint16_t)out.ev[e].value >> 8),
+      };
+      uint32_t idx = (uint32_t)i;
+
+      digest = fnv1a(digest, &idx, sizeof(idx));
+      digest = fnv1a(digest, rec, sizeof(rec));
+      events++;
+      if (full) {
+        printf("%zu %u %d%s\n", i, out.ev[e].code, out.ev[e].value,
+               out.ev[e].sync ? " SYN" : "");
+      }
+    }
+  }
+
+  if (!full) {
+    printf("%d %u %u %u %u %u %lu %lu %016llx\n", mode, params->rotation,
+           params->snipe_divisor, params->scroll_snipe_divisor,
+           params->scroll_tick, params->scroll_snipe_tick, events, clamped,
+           (unsigned long long)digest);
+  }
+}
+
+int main(int argc, char **argv) {
+  struct paw32xx_core_params p;
+  int full = argc > 1 && strcmp(argv[1], "--full") == 0;
+
+  if (argc > 1 && !full) {
+    fprintf(stderr, "usage: %s [--full]\n", argv[0]);
+    return 2;
+  }
+
+  make_samples();
+
+  if (!full) {
+    printf("# mode rotation snipe_divisor scroll_snipe_divisor scroll_tick "
+           "scroll_snipe_tick events clamped digest\n");
+  }
+
+  for (int mode = PAW32XX_MOVE; mode <= PAW32XX_BOTHSCROLL_SNIPE; mode++) {
+    for (size_t r = 0; r < ARRAY_LEN(rotations); r++) {
+      for (size_t sd = 0; sd < ARRAY_LEN(snipe_divisors); sd++) {
+        for (size_t ssd = 0; ssd < ARRAY_LEN(scroll_snipe_divisors); ssd++) {
+          for (size_t st = 0; st < ARRAY_LEN(scroll_ticks); st++) {
+            for (size_t sst = 0; sst < ARRAY_LEN(scroll_snipe_ticks); sst++) {
+              p.rotation = rotations[r];
+              p.snipe_divisor = snipe_divisors[sd];
+              p.scroll_snipe_divisor = scroll_snipe_divisors[ssd];
+              p.scroll_tick = scroll_ticks[st];
+              p.scroll_snipe_tick = scroll_snipe_ticks[sst];
+              run(&p, mode, full);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replay a PAW3222 motion recording through the driver's motion pipeline
+ * on the host.
+ *
+ *   paw3222_replay [options] <recording>
+ *
+ * The recording is either the binary ring or the text printed by
+ * "paw3222 record dump". Events go to stdout, one per line, so two
+ * configurations or two builds can be compared with diff:
+ *
+ *   <t_us> REL_X|REL_Y|REL_WHEEL|REL_HWHEEL <value>
+ *   <t_us> SYN
+ *
+ * A summary and the pipeline timing go to stderr.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "paw3222_core.h"
+#include "paw3222_recfmt.h"
+
+static const char *const code_names[] = {
+    [PAW32XX_CORE_REL_X] = "REL_X",
+    [PAW32XX_CORE_REL_Y] = "REL_Y",
+    [PAW32XX_CORE_REL_WHEEL] = "REL_WHEEL",
+    [PAW32XX_CORE_REL_HWHEEL] = "REL_HWHEEL",
+};
+
+/* Sample with the boot it was recorded in, in recording order */
+struct replay_sample {
+  struct paw32xx_rec_sample s;
+  uint8_t boot;
+};
+
+struct replay_opts {
+  struct paw32xx_core_params params;
+  int mode;      /* forced input mode, -1 to use the recorded one */
+  long repeat;   /* timing passes */
+  int quiet;     /* no event output */
+};
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [options] <recording>\n"
+          "  -r, --rotation DEG              sensor rotation (0)\n"
+          "  -d, --snipe-divisor N           snipe cursor divisor (2)\n"
+          "  -D, --scroll-snipe-divisor N    scroll snipe divisor (3)\n"
+          "  -t, --scroll-tick N             scroll tick (10)\n"
+          "  -T, --scroll-snipe-tick N       scroll snipe tick (20)\n"
+          "  -m, --mode N                    force input mode 0-%d\n"
+          "  -n, --repeat N                  timing passes (100)\n"
+          "  -q, --quiet                     no event output\n",
+          prog, PAW32XX_BOTHSCROLL_SNIPE);
+}
+
+static int parse_long(const char *s, long min, long max, long *out) {
+  char *end;
+  long v;
+
+  errno = 0;
+  v = strtol(s, &end, 0);
+  if (errno != 0 || *end != '\0' || v < min || v > max) {
+    return -EINVAL;
+  }
+
+  *out = v;
+  return 0;
+}
+
+/* Reads the whole file and turns a hex dump into binary if needed */
+static uint8_t *load_recording(const char *path, size_t *len) {
+  FILE *f = fopen(path, "rb");
+  uint8_t *buf = NULL, *bin;
+  size_t cap = 0, n = 0, out = 0;
+  int c, hi = -1;
+
+  if (f == NULL) {
+    perror(path);
+    return NULL;
+  }
+
+  while ((c = fgetc(f)) != EOF) {
+    if (n == cap) {
+      cap = cap ? 2 * cap : 4096;
+      buf = realloc(buf, cap);
+      if (buf == NULL) {
+        fclose(f);
+        return NULL;
+      }
+    }
+    buf[n++] = (uint8_t)c;
+  }
+  fclose(f);
+
+  if (n >= 4 && buf[0] == 'P' && buf[1] == 'A' && buf[2] == 'W' &&
+      buf[3] == 'R') {
+    *len = n;
+    return buf;
+  }
+
+  /* Text dump: skip '#' comment lines, collect hex digit pairs */
+  bin = malloc(n / 2 + 1);
+  if (bin == NULL) {
+    free(buf);
+    return NULL;
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (buf[i] == '#') {
+      while (i < n && buf[i] != '\n') {
+        i++;
+      }
+      continue;
+    }
+    if (!isxdigit(buf[i])) {
+      continue;
+    }
+    c = isdigit(buf[i]) ? buf[i] - '0' : tolower(buf[i]) - 'a' + 10;
+    if (hi < 0) {
+      hi = c;
+    } else {
+      bin[out++] = (uint8_t)(hi << 4 | c);
+      hi = -1;
+    }
+  }
+  free(buf);
+
+  *len = out;
+  return bin;
+}
+
+/* Decodes all blocks, oldest first */
+static struct replay_sample *decode_recording(const uint8_t *raw, size_t len,
+                                              size_t *count) {
+  struct paw32xx_rec_ring_hdr hdr;
+  struct replay_sample *samples;
+  size_t n = 0;
+
+  if (paw32xx_rec_parse_hdr(raw, len, &hdr) < 0) {
+    fprintf(stderr, "not a version %d recording\n", PAW32XX_REC_VERSION);
+    return NULL;
+  }
+
+  /* A sample takes at least 4 bytes */
+  samples = calloc((size_t)hdr.block_count * PAW32XX_REC_PAYLOAD_SIZE / 4 + 1,
+                   sizeof(*samples));
+  if (samples == NULL) {
+    return NULL;
+  }
+
+  for (uint16_t i = 0; i < hdr.block_count; i++) {
+    uint16_t seq = hdr.next_seq + i;
+    const uint8_t *block = raw + PAW32XX_REC_RING_HDR_SIZE +
+                           (size_t)(seq & (hdr.block_count - 1)) *
+                               PAW32XX_REC_BLOCK_SIZE;
+    struct paw32xx_rec_block_hdr bhdr;
+    struct paw32xx_rec_cursor cur;
+    int ret;
+
+    if (paw32xx_rec_block_begin(block, &bhdr, &cur) < 0) {
+      continue;
+    }
+    while ((ret = paw32xx_rec_next(&cur, &samples[n].s)) > 0) {
+      samples[n++].boot = bhdr.boot;
+    }
+    if (ret < 0) {
+      fprintf(stderr, "block %u is corrupt, skipping the rest of it\n",
+              bhdr.seq);
+    }
+  }
+
+  *count = n;
+  return samples;
+}
+
+static uint8_t sample_mode(const struct replay_opts *opts,
+                           const struct replay_sample *rs) {
+  if (opts->mode >= 0) {
+    return (uint8_t)opts->mode;
+  }
+
+  return rs->s.flags & PAW32XX_REC_FLAG_MODE_MASK;
+}
+
+/*
+ * Runs the pipeline over all samples. Scroll state is dropped when the
+ * input mode changes, as paw32xx_apply_mode() does on target, and when a
+ * new boot starts.
+ */
+static unsigned long replay(const struct replay_opts *opts,
+                            const struct replay_sample *samples, size_t count,
+                            FILE *out) {
+  struct paw32xx_core_state state;
+  struct paw32xx_core_out ev;
+  unsigned long events = 0;
+  int prev_mode = -1, prev_boot = -1;
+
+  paw32xx_core_reset(&state);
+
+  for (size_t i = 0; i < count; i++) {
+    uint8_t mode = sample_mode(opts, &samples[i]);
+
+    if (mode != prev_mode || samples[i].boot != prev_boot) {
+      paw32xx_core_reset(&state);
+      prev_mode = mode;
+      prev_boot = samples[i].boot;
+    }
+
+    if (paw32xx_core_process(&opts->params, &state, mode, samples[i].s.x,
+                             samples[i].s.y, &ev) < 0) {
+      if (out != NULL) {
+        fprintf(stderr, "sample %zu: unknown input mode %u\n", i, mode);
+      }
+      continue;
+    }
+
+    events += ev.count;
+    if (out == NULL) {
+      continue;
+    }
+    for (uint8_t e = 0; e < ev.count; e++) {
+      fprintf(out, "%u %s %d\n", samples[i].s.t_us, code_names[ev.ev[e].code],
+              ev.ev[e].value);
+      if (ev.ev[e].sync) {
+        fprintf(out, "%u SYN\n", samples[i].s.t_us);
+      }
+    }
+  }
+
+  return events;
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+  static const struct option long_opts[] = {
+      {"rotation", required_argument, NULL, 'r'},
+      {"snipe-divisor", required_argument, NULL, 'd'},
+      {"scroll-snipe-divisor", required_argument, NULL, 'D'},
+      {"scroll-tick", required_argument, NULL, 't'},
+      {"scroll-snipe-tick", required_argument, NULL, 'T'},
+      {"mode", required_argument, NULL, 'm'},
+      {"repeat", required_argument, NULL, 'n'},
+      {"quiet", no_argument, NULL, 'q'},
+      {NULL, 0, NULL, 0},
+  };
+  struct replay_opts opts = {
+      .params =
+          {
+              .rotation = 0,
+              .snipe_divisor = 2,
+              .scroll_snipe_divisor = 3,
+              .scroll_tick = 10,
+              .scroll_snipe_tick = 20,
+          },
+      .mode = -1,
+      .repeat = 100,
+  };
+  struct replay_sample *samples;
+  unsigned long events;
+  volatile unsigned long sink = 0;
+  uint8_t *raw;
+  size_t len, count;
+  double t0, t1;
+  long v;
+  int c;
+
+  while ((c = getopt_long(argc, argv, "r:d:D:t:T:m:n:q", long_opts, NULL)) !=
+         -1) {
+    switch (c) {
+    case 'r':
+      if (parse_long(optarg, 0, 270, &v) < 0 || v % 90 != 0) {
+        goto bad_arg;
+      }
+      opts.params.rotation = (uint16_t)v;
+      break;
+    case 'd':
+      if (parse_long(optarg, 1, 255, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.params.snipe_divisor = (uint8_t)v;
+      break;
+    case 'D':
+      if (parse_long(optarg, 1, 255, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.params.scroll_snipe_divisor = (uint8_t)v;
+      break;
+    case 't':
+      if (parse_long(optarg, 1, 255, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.params.scroll_tick = (uint8_t)v;
+      break;
+    case 'T':
+      if (parse_long(optarg, 1, 255, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.params.scroll_snipe_tick = (uint8_t)v;
+      break;
+    case 'm':
+      if (parse_long(optarg, 0, PAW32XX_BOTHSCROLL_SNIPE, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.mode = (int)v;
+      break;
+    case 'n':
+      if (parse_long(optarg, 0, 1000000, &v) < 0) {
+        goto bad_arg;
+      }
+      opts.repeat = v;
+      break;
+    case 'q':
+      opts.quiet = 1;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (optind != argc - 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  raw = load_recording(argv[optind], &len);
+  if (raw == NULL) {
+    return 1;
+  }
+  samples = decode_recording(raw, len, &count);
+  free(raw);
+  if (samples == NULL) {
+    return 1;
+  }
+
+  events = replay(&opts, samples, count, opts.quiet ? NULL : stdout);
+
+  t0 = now_ns();
+  for (long i = 0; i < opts.repeat; i++) {
+    sink += replay(&opts, samples, count, NULL);
+  }
+  t1 = now_ns();
+
+  fprintf(stderr, "samples: %zu\nevents: %lu\n", count, events);
+  if (opts.repeat > 0 && count > 0) {
+    fprintf(stderr, "pipeline: %.1f ns/sample over %ld passes\n",
+            (t1 - t0) / ((double)opts.repeat * (double)count), opts.repeat);
+  }
+
+  free(samples);
+  return 0;
+
+bad_arg:
+  fprintf(stderr, "invalid value for -%c: %s\n", c, optarg);
+  return 2;
+}
@@ -0,0 +1,450 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "paw3222_sim.h"
+
+/* SPI traffic of one register read or write: address byte plus data */
+#define SIM_REG_BYTES 2
+
+static void trace(struct sim *s, const char *fmt, ...) {
+  va_list ap;
+
+  if (!s->cfg->verbose) {
+    return;
+  }
+  printf("  %12.6f  ", (double)s->now / 1e6);
+  va_start(ap, fmt);
+  vprintf(fmt, ap);
+  va_end(ap);
+  putchar('\n');
+}
+
+void sim_violation(struct sim *s, const char *what) {
+  s->violations++;
+  printf("  VIOLATION at %.6f s: %s\n", (double)s->now / 1e6, what);
+}
+
+static void spi(struct sim *s, uint32_t xfers, uint32_t bytes) {
+  s->cnt.spi_xfers += xfers;
+  s->cnt.spi_bytes += bytes;
+}
+
+static void submit(struct sim *s, enum sim_work_id id) {
+  bool *queued = (id == SIM_WORK_MOTION) ? &s->queued_motion : &s->queued_idle;
+
+  /* k_work_submit(): no-op while queued, requeued while running */
+  if (*queued) {
+    return;
+  }
+  *queued = true;
+  if (s->queued == 0 && !s->running) {
+    s->ready_at = s->now + s->cfg->latency_us;
+  }
+  s->queue[s->queued++] = id;
+}
+
+static void work_done(struct sim *s) {
+  s->running = false;
+  s->ready_at = (s->queued > 0) ? s->now + s->cfg->latency_us : SIM_NEVER;
+}
+
+static bool motion_in_flight(const struct sim *s) {
+  return s->queued_motion || (s->running && s->cur == SIM_WORK_MOTION);
+}
+
+static void raise_event(struct sim *s, enum paw32xx_idle_event ev);
+static void isr(struct sim *s);
+
+static bool stuck(const struct sim *s) {
+  return s->now >= s->cfg->stuck.start && s->now < s->cfg->stuck.end;
+}
+
+static void line_update(struct sim *s) {
+  bool line = s->pending > 0 || stuck(s);
+
+  if (line && s->line_since == SIM_NEVER) {
+    s->line_since = s->now;
+    if (s->irq_en) {
+      trace(s, "edge");
+      isr(s);
+      s->cnt.irqs++;
+      raise_event(s, PAW32XX_IDLE_EV_IRQ);
+    } else {
+      trace(s, "edge (interrupt disabled)");
+    }
+  } else if (!line) {
+    s->line_since = SIM_NEVER;
+  }
+}
+
+static void log_sleep(struct sim *s, char what) {
+  int n = s->sleep_count + s->wake_count;
+
+  if (n < SIM_MAX_SLEEP_LOG) {
+    s->sleep_log_t[n] = s->now;
+    s->sleep_log[n] = what;
+  }
+}
+
+/* paw3222_set_sleep(): write protect off, update OPERATION_MODE, back on */
+static void set_sleep(struct sim *s, bool sleep) {
+  if (s->cfg->no_sleep) {
+    return;
+  }
+  spi(s, 4, 4 * SIM_REG_BYTES);
+  s->cnt.mcu_active_us += 4 * SIM_SPI_US;
+  s->asleep = sleep;
+}
+
+static void apply(struct sim *s, uint16_t act, bool probe) {
+  if (act & PAW32XX_IDLE_ACT_IRQ_OFF) {
+    s->irq_en = false;
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_STOP) {
+    s->poll_at = SIM_NEVER;
+  }
+  if ((act & (PAW32XX_IDLE_ACT_WAKE | PAW32XX_IDLE_ACT_SLEEP)) && probe) {
+    /* Fallback probe of a faulted line: not an idle transition */
+    if (act & PAW32XX_IDLE_ACT_WAKE) {
+      if (!s->asleep && !s->cfg->no_sleep) {
+        sim_violation(s, "probe while awake");
+      }
+      s->probes++;
+    }
+    set_sleep(s, (act & PAW32XX_IDLE_ACT_SLEEP) != 0);
+    act &= ~(PAW32XX_IDLE_ACT_WAKE | PAW32XX_IDLE_ACT_SLEEP);
+  }
+  if (act & PAW32XX_IDLE_ACT_WAKE) {
+    log_sleep(s, 'W');
+    if (!s->asleep && !s->cfg->no_sleep) {
+      sim_violation(s, "wake request while awake");
+    }
+    s->wake_count++;
+    set_sleep(s, false);
+    trace(s, "set_sleep(false)");
+  }
+  if (act & PAW32XX_IDLE_ACT_SLEEP) {
+    log_sleep(s, 'S');
+    if (s->asleep) {
+      sim_violation(s, "sleep request while asleep");
+    }
+    if (s->last_sample != SIM_NEVER &&
+        s->now < s->last_sample + s->cfg->timeout_us) {
+      sim_violation(s, "idle entered before the timeout");
+    }
+    s->sleep_count++;
+    set_sleep(s, true);
+    trace(s, "set_sleep(true)");
+  }
+  if (act & PAW32XX_IDLE_ACT_IRQ_ON) {
+    /* Edge triggered: enabling while the line is high raises nothing */
+    s->irq_en = true;
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL) {
+    s->poll_at = s->now + s->cfg->poll_us;
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_REDUCED) {
+    s->poll_at = s->now + s->cfg->reduced_us;
+  }
+  if (act & PAW32XX_IDLE_ACT_ARM_TIMEOUT) {
+    s->idle_at = s->now + s->cfg->timeout_us;
+  }
+  if ((act & PAW32XX_IDLE_ACT_RUN) ||
+      ((act & PAW32XX_IDLE_ACT_RECHECK) && s->pending > 0)) {
+    submit(s, SIM_WORK_MOTION);
+  }
+  if (act & PAW32XX_IDLE_ACT_TIMEOUT_WORK) {
+    submit(s, SIM_WORK_IDLE);
+  }
+  if (act & PAW32XX_IDLE_ACT_POLL_FALLBACK) {
+    s->poll_at = s->now + (s->sm.idle ? SIM_LINE_FALLBACK_IDLE_US
+                                      : SIM_LINE_FALLBACK_US);
+  }
+}
+
+static void raise_event(struct sim *s, enum paw32xx_idle_event ev) {
+  static const char *const names[] = {
+      [PAW32XX_IDLE_EV_IRQ] = "IRQ",       [PAW32XX_IDLE_EV_POLL] = "POLL",
+      [PAW32XX_IDLE_EV_RUN] = "RUN",       [PAW32XX_IDLE_EV_SAMPLE] = "SAMPLE",
+      [PAW32XX_IDLE_EV_QUIET] = "QUIET",   [PAW32XX_IDLE_EV_EXPIRE] = "EXPIRE",
+      [PAW32XX_IDLE_EV_TIMEOUT] = "TIMEOUT", [PAW32XX_IDLE_EV_PHANTOM] = "PHANTOM",
+      [PAW32XX_IDLE_EV_FAULT] = "FAULT",   [PAW32XX_IDLE_EV_CLEAR] = "CLEAR",
+  };
+  bool probe = s->sm.probe;
+  uint16_t act = paw32xx_idle_step(&s->sm, ev);
+
+  trace(s, "%-7s -> actions 0x%03x%s%s", names[ev], act,
+        s->sm.idle ? " (idle)" : "", s->sm.fault ? " (fault)" : "");
+  apply(s, act, probe || s->sm.probe);
+  if (probe && !s->sm.probe && !s->sm.idle) {
+    /* The probe found motion: the idle exit its wake stood for */
+    log_sleep(s, 'W');
+    s->wake_count++;
+  }
+}
+
+/* Skips the bursts that ended by t; returns the one that has not */
+static const struct sim_burst *burst_at(struct sim *s, uint64_t t) {
+  while (s->burst_idx < s->burst_count && s->bursts[s->burst_idx].end <= t) {
+    s->burst_idx++;
+  }
+  return s->burst_idx < s->burst_count ? &s->bursts[s->burst_idx] : NULL;
+}
+
+static void sensor_frame(struct sim *s) {
+  const struct sim_burst *b = burst_at(s, s->now);
+
+  if (b != NULL && b->start <= s->now) {
+    if (!s->asleep) {
+      s->cnt.sensor_run_us += SIM_FRAME_US;
+    }
+    if (s->pending++ == 0) {
+      s->motion_since = s->now;
+    }
+    line_update(s);
+    s->next_frame = s->now + (s->asleep ? SIM_SLEEP_FRAME_US : SIM_FRAME_US);
+  } else {
+    s->next_frame = b != NULL ? b->start : SIM_NEVER;
+  }
+}
+
+static void motion_step(struct sim *s) {
+  switch (s->step) {
+  case SIM_STEP_RUN:
+    raise_event(s, PAW32XX_IDLE_EV_RUN);
+    s->step = SIM_STEP_READ_MOTION;
+    s->step_at = s->now + SIM_SPI_US;
+    spi(s, 1, SIM_REG_BYTES);
+    return;
+
+  case SIM_STEP_READ_MOTION:
+    if (s->asleep) {
+      sim_violation(s, "sensor read while asleep");
+    }
+    s->line_only = false;
+    if (s->pending == 0) {
+      if (s->sm.fault) {
+        /* paw32xx_line_fault_quiet() */
+        if (s->line_since == SIM_NEVER &&
+            s->now - s->fault_at >= SIM_LINE_RETRY_US) {
+          s->clears++;
+          raise_event(s, PAW32XX_IDLE_EV_CLEAR);
+        } else {
+          raise_event(s, PAW32XX_IDLE_EV_QUIET);
+        }
+        work_done(s);
+        return;
+      }
+      raise_event(s, PAW32XX_IDLE_EV_QUIET);
+      if (s->line_since == SIM_NEVER) {
+        s->phantom_runs = 0;
+        work_done(s);
+        return;
+      }
+      s->line_only = true;
+    }
+    /* paw32xx_read_xy(): DELTA_X and DELTA_Y in one transfer */
+    s->step = SIM_STEP_READ_XY;
+    s->step_at = s->now + 2 * SIM_SPI_US;
+    spi(s, 1, 2 * SIM_REG_BYTES);
+    return;
+
+  case SIM_STEP_READ_XY:
+    if (s->asleep) {
+      sim_violation(s, "sensor read while asleep");
+    }
+    if (s->line_only && s->pending == 0) {
+      /* paw32xx_line_phantom() */
+      if (++s->phantom_runs >= SIM_LINE_STUCK_RUNS) {
+        trace(s, "line stuck, sensor reset");
+        s->phantom_runs = 0;
+        s->faults++;
+        s->fault_at = s->now;
+        /* paw32xx_reinit() stops the motion timer */
+        spi(s, 8, 8 * SIM_REG_BYTES);
+        s->poll_at = SIM_NEVER;
+        raise_event(s, PAW32XX_IDLE_EV_FAULT);
+      } else {
+        raise_event(s, PAW32XX_IDLE_EV_PHANTOM);
+      }
+      work_done(s);
+      return;
+    }
+    s->phantom_runs = 0;
+    if (s->motion_since != SIM_NEVER) {
+      uint64_t wait = s->now - s->motion_since;
+
+      if (wait > s->max_wake_us) {
+        s->max_wake_us = wait;
+      }
+    }
+    trace(s, "read %u counts", s->pending);
+    if (s->pending > 0) {
+      s->cnt.reports++;
+    }
+    s->pending = 0;
+    s->motion_since = SIM_NEVER;
+    line_update(s);
+    s->samples++;
+    s->last_sample = s->now;
+    s->step = SIM_STEP_DONE;
+    s->step_at = s->now + SIM_PROCESS_US;
+    return;
+
+  case SIM_STEP_DONE:
+    if (s->wake_count > 0 && s->wake_sample == SIM_NEVER) {
+      s->wake_sample = s->now;
+    }
+    raise_event(s, PAW32XX_IDLE_EV_SAMPLE);
+    work_done(s);
+    return;
+  }
+}
+
+/* Line high with nothing left that would ever read it */
+static bool lost_wake(const struct sim *s) {
+  return s->line_since != SIM_NEVER && !motion_in_flight(s) &&
+         s->poll_at == SIM_NEVER && s->idle_at == SIM_NEVER && !s->queued_idle;
+}
+
+static uint64_t min3(uint64_t a, uint64_t b, uint64_t c) {
+  uint64_t m = a < b ? a : b;
+
+  return m < c ? m : c;
+}
+
+/* Time accounting up to t; the CPU is busy while work is queued or runs */
+static void advance(struct sim *s, uint64_t t) {
+  uint64_t dt = t - s->now;
+
+  if (s->running || s->ready_at != SIM_NEVER) {
+    s->cnt.mcu_active_us += dt;
+  }
+  if (s->asleep) {
+    s->cnt.sensor_sleep_us += dt;
+  }
+  s->now = t;
+}
+
+/* Interrupt entry: wakes the MCU unless the work queue kept it busy */
+static void isr(struct sim *s) {
+  if (!s->running && s->ready_at == SIM_NEVER) {
+    s->cnt.mcu_wakeups++;
+  }
+  s->cnt.mcu_active_us += SIM_ISR_US;
+}
+
+/* Next time the stuck window starts or ends */
+static uint64_t stuck_at(const struct sim *s) {
+  if (s->cfg->stuck.end <= s->cfg->stuck.start) {
+    return SIM_NEVER;
+  }
+  if (s->now < s->cfg->stuck.start) {
+    return s->cfg->stuck.start;
+  }
+  return s->now < s->cfg->stuck.end ? s->cfg->stuck.end : SIM_NEVER;
+}
+
+void sim_run(struct sim *s, uint64_t end) {
+  while (s->now <= end) {
+    uint64_t work_at = s->running ? s->step_at : s->ready_at;
+    uint64_t line_at = stuck_at(s);
+    uint64_t t;
+
+    t = min3(s->next_frame, min3(s->poll_at, s->idle_at, line_at), work_at);
+    if (t == SIM_NEVER || t > end) {
+      break;
+    }
+    advance(s, t);
+
+    /* Interrupts first, then the work queue */
+    if (t == s->next_frame) {
+      sensor_frame(s);
+    } else if (t == line_at) {
+      trace(s, "line %s", stuck(s) ? "stuck" : "released");
+      line_update(s);
+    } else if (t == s->poll_at) {
+      isr(s);
+      s->cnt.timer_irqs++;
+      s->poll_at = SIM_NEVER;
+      if (s->wake_sample != SIM_NEVER && s->first_poll == SIM_NEVER) {
+        s->first_poll = s->now;
+      }
+      raise_event(s, PAW32XX_IDLE_EV_POLL);
+    } else if (t == s->idle_at) {
+      isr(s);
+      s->cnt.timer_irqs++;
+      s->idle_at = SIM_NEVER;
+      raise_event(s, PAW32XX_IDLE_EV_EXPIRE);
+    } else if (s->running) {
+      motion_step(s);
+    } else {
+      s->cur = s->queue[0];
+      s->queue[0] = s->queue[1];
+      s->queued--;
+      s->running = true;
+      s->ready_at = SIM_NEVER;
+      s->cnt.work_items++;
+      if (s->cur == SIM_WORK_MOTION) {
+        s->queued_motion = false;
+        s->step = SIM_STEP_RUN;
+        motion_step(s);
+      } else {
+        s->queued_idle = false;
+        raise_event(s, PAW32XX_IDLE_EV_TIMEOUT);
+        work_done(s);
+      }
+    }
+
+    if (lost_wake(s) && !s->lost_reported) {
+      sim_violation(s, "motion pending but nothing will read it (lost wake)");
+      s->lost_reported = true;
+    }
+  }
+  if (end != SIM_NEVER && end > s->now) {
+    advance(s, end);
+  }
+}
+
+void sim_init(struct sim *s, const struct sim_cfg *cfg,
+              const struct sim_burst *bursts, int count) {
+  const struct sim_burst *first;
+
+  memset(s, 0, sizeof(*s));
+  s->cfg = cfg;
+  s->bursts = bursts;
+  s->burst_count = count;
+  s->line_since = SIM_NEVER;
+  s->motion_since = SIM_NEVER;
+  s->last_sample = SIM_NEVER;
+  s->wake_sample = SIM_NEVER;
+  s->first_poll = SIM_NEVER;
+  s->poll_at = SIM_NEVER;
+  s->idle_at = SIM_NEVER;
+  s->ready_at = SIM_NEVER;
+  first = burst_at(s, 0);
+  s->next_frame = first != NULL ? first->start : SIM_NEVER;
+  paw32xx_idle_init(&s->sm, cfg->reduced_scan);
+  /* Driver init: interrupt armed, nothing else running */
+  s->irq_en = true;
+}
+
+/* Wake bound: the sensor notices motion, the edge runs the work */
+uint64_t sim_wake_bound(const struct sim_cfg *cfg) {
+  uint64_t poll = cfg->poll_us > cfg->reduced_us ? cfg->poll_us
+                                                 : cfg->reduced_us;
+
+  if (cfg->stuck.end > cfg->stuck.start && poll < SIM_LINE_FALLBACK_IDLE_US) {
+    poll = SIM_LINE_FALLBACK_IDLE_US;
+  }
+
+  return SIM_SLEEP_FRAME_US + poll + 2 * cfg->latency_us + 4 * SIM_SPI_US +
+         SIM_PROCESS_US;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 nuovotaka
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Virtual-time model of the driver's idle / motion path, shared by the
+ * host tools.
+ *
+ * Drives src/paw3222_idle.c exactly as paw3222_input.c does, against a
+ * model of the sensor (motion line, clear-on-read deltas, slower frames
+ * while asleep), the motion interrupt (edge to active, lost while
+ * disabled), the two kernel timers and a single-threaded work queue with
+ * k_work submit semantics. Time advances from event to event, so a 300 s
+ * idle timeout costs nothing.
+ *
+ * While it runs the model checks that the sensor is never read asleep,
+ * that sleep and wake requests alternate, that idle is not entered before
+ * the timeout and that motion is never left with nothing to read it, and
+ * counts what an energy estimate needs: MCU wakeups, SPI traffic, reports
+ * and the time spent in each power state.
+ *
+ * A stuck motion line (sim_cfg.stuck) is answered the way
+ * src/paw3222_line.c answers it: phantom runs, a fault after
+ * SIM_LINE_STUCK_RUNS of them, fallback polling with probes while idle and
+ * a clear once the line is released and the retry time has passed.
+ */
+
+#ifndef PAW3222_SIM_H_
+#define PAW3222_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "paw3222_idle.h"
+
+#define SIM_NEVER UINT64_MAX
+#define SIM_MAX_SLEEP_LOG 16
+
+/*
+ * The timings below are placeholders for the model, not measurements: the
+ * wake bound depends on them, and paw3222_energy counts time with them.
+ */
+
+/* Sensor frame periods, awake and in the sensor's own sleep mode */
+#define SIM_FRAME_US 1000
+#define SIM_SLEEP_FRAME_US 20000
+/* One register access over SPI */
+#define SIM_SPI_US 40
+/* Report and pipeline time of a sample */
+#define SIM_PROCESS_US 150
+/* Entry, handler and exit of one interrupt */
+#define SIM_ISR_US 5
+
+/* Motion line monitor, the CONFIG_PAW3222_LINE_* defaults */
+#define SIM_LINE_STUCK_RUNS 3
+#define SIM_LINE_FALLBACK_US 20000
+#define SIM_LINE_FALLBACK_IDLE_US 500000
+#define SIM_LINE_RETRY_US 30000000ULL
+
+/* Motion on the sensor from start to end, in µs; sorted, not overlapping */
+struct sim_burst {
+  uint64_t start;
+  uint64_t end;
+};
+
+struct sim_cfg {
+  uint64_t timeout_us;
+  uint64_t poll_us;
+  uint64_t reduced_us;
+  uint64_t latency_us; /* submit to start of a work item */
+  bool reduced_scan;
+  bool no_sleep; /* CONFIG_PAW3222_POWER_CTRL=n: set_sleep() does nothing */
+  struct sim_burst stuck; /* line held asserted; none if end <= start */
+  int verbose;
+};
+
+/* What the run cost, for the energy model */
+struct sim_counters {
+  uint32_t mcu_wakeups; /* interrupts taken with the work queue idle */
+  uint32_t irqs;        /* motion line edges */
+  uint32_t timer_irqs;  /* motion and idle timer expiries */
+  uint32_t work_items;
+  uint32_t spi_xfers;
+  uint64_t spi_bytes;
+  uint32_t reports;     /* samples read and reported */
+  uint64_t mcu_active_us;
+  uint64_t sensor_run_us;   /* awake frames with motion */
+  uint64_t sensor_sleep_us; /* in the sleep mode set_sleep() requests */
+};
+
+enum sim_work_id { SIM_WORK_MOTION, SIM_WORK_IDLE };
+
+/* Motion work steps, mirroring paw32xx_motion_work_handler() */
+enum sim_motion_step {
+  SIM_STEP_RUN,
+  SIM_STEP_READ_MOTION,
+  SIM_STEP_READ_XY,
+  SIM_STEP_DONE,
+};
+
+struct sim {
+  const struct sim_cfg *cfg;
+  uint64_t now;
+
+  /* Sensor */
+  const struct sim_burst *bursts;
+  int burst_count;
+  int burst_idx; /* first burst that has not ended */
+  bool asleep;
+  uint32_t pending;
+  uint64_t next_frame;
+  uint64_t line_since; /* time the line went high, SIM_NEVER while low */
+  uint64_t motion_since; /* first unread count, SIM_NEVER if none */
+
+  /* Driver */
+  struct paw32xx_idle_sm sm;
+  bool irq_en;
+  uint64_t poll_at;
+  uint64_t idle_at;
+
+  /* Work queue: FIFO of at most one entry per item, plus the running one */
+  enum sim_work_id queue[2];
+  int queued;
+  bool queued_motion, queued_idle;
+  uint64_t ready_at; /* head of the queue starts, SIM_NEVER while busy or empty */
+  bool running;
+  enum sim_work_id cur;
+  enum sim_motion_step step;
+  uint64_t step_at;
+  bool line_only; /* the run found the line high but no motion */
+
+  /* Line monitor */
+  uint32_t phantom_runs;
+  uint64_t fault_at;
+
+  /* Results */
+  char sleep_log[SIM_MAX_SLEEP_LOG];
+  uint64_t sleep_log_t[SIM_MAX_SLEEP_LOG];
+  int sleep_count, wake_count;
+  uint64_t last_sample;
+  uint64_t wake_sample; /* first sample processed after a wake */
+  uint64_t first_poll;  /* first motion timer expiry after wake_sample */
+  uint64_t max_wake_us;
+  uint32_t samples;
+  uint32_t violations;
+  bool lost_reported;
+  uint32_t faults, clears, probes;
+  struct sim_counters cnt;
+};
+
+/**
+ * Reset the model to the state after driver init, with the given motion.
+ * The bursts are not copied and must outlive the run.
+ */
+void sim_init(struct sim *s, const struct sim_cfg *cfg,
+              const struct sim_burst *bursts, int count);
+
+/** Advance virtual time up to and including end */
+void sim_run(struct sim *s, uint64_t end);
+
+/** Count and print an invariant violation at the current time */
+void sim_violation(struct sim *s, const char *what);
+
+/**
+ * Longest time from motion to its sample that is not a violation; with a
+ * stuck line, the idle fallback interval replaces the poll interval.
+ */
+uint64_t sim_wake_bound(const struct sim_cfg *cfg);
+
+#endif /* PAW3222_SIM_H_ */